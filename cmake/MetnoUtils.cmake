@@ -4,7 +4,7 @@ SET(CMAKE_VERBOSE_MAKEFILE OFF)
 
 INCLUDE(GNUInstallDirs)
 INCLUDE(FindPkgConfig)
-SET(CMAKE_CXX_STANDARD 11)
+SET(CMAKE_CXX_STANDARD 17)
 
 #########################################################################
 
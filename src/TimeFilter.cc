@@ -33,6 +33,8 @@
 
 #include "TimeFilter.h"
 
+#include "miNumberParse.h"
+
 #include <stdexcept>
 #include <sstream>
 
@@ -55,7 +57,7 @@ std::string::size_type replace_first_if(std::string& s, const char* thys, int si
   return idx;
 }
 
-void parse_time_int(const std::string& text, std::string::size_type idx, size_t count, std::string::size_type offset, int& value)
+void parse_time_int(std::string_view text, std::string::size_type idx, size_t count, std::string::size_type offset, int& value)
 {
   if (idx == std::string::npos)
     return;
@@ -65,13 +67,9 @@ void parse_time_int(const std::string& text, std::string::size_type idx, size_t
   if (count < 1 || idx+count > text.size())
     throw std::runtime_error("end of string");
 
-  value = 0;
-  for (size_t i=0; i<count; ++i, ++idx) {
-    char ch = text[idx];
-    if (ch < '0' || ch > '9')
-      throw std::runtime_error("no digit");
-    value = 10*value + (ch - '0');
-  }
+  const char* digits = text.data() + idx;
+  if (!miutil::parse_digits(digits, digits + count, value))
+    throw std::runtime_error("no digit");
 }
 } /*anonymous namespace*/
 
@@ -188,7 +186,7 @@ std::string TimeFilter::parse(const std::string& filename)
   return pattern.str();
 }
 
-bool TimeFilter::getTime(const std::string& name, miutil::miTime &time) const
+bool TimeFilter::getTime(std::string_view name, miutil::miTime &time) const
 {
   if (!ok() || name.empty())
     return false;
@@ -196,7 +194,7 @@ bool TimeFilter::getTime(const std::string& name, miutil::miTime &time) const
   int offset = 0;
   if (noSlash) {
     const std::string::size_type slash = name.find_last_of("/");
-    if (slash != std::string::npos)
+    if (slash != std::string_view::npos)
       offset = slash + 1;
   }
 
@@ -231,7 +229,7 @@ bool TimeFilter::getTime(const std::string& name, miutil::miTime &time) const
   return false;
 }
 
-std::string TimeFilter::getTimeStr(const std::string& filename) const
+std::string TimeFilter::getTimeStr(std::string_view filename) const
 {
   if (ok()) {
     miutil::miTime time;
@@ -51,9 +51,9 @@ public:
   bool ok() const;
 
   /// find time from filename
-  bool getTime(const std::string& name, miutil::miTime& t) const;
+  bool getTime(std::string_view name, miutil::miTime& t) const;
 
-  std::string getTimeStr(const std::string& name) const;
+  std::string getTimeStr(std::string_view name) const;
 
 private:
   std::string parse(const std::string& filename);
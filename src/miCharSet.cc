@@ -0,0 +1,270 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miCharSet.h"
+
+#include "miStringFunctions.h"
+
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define PUTOOLS_CHARSET_X86 1
+#include <immintrin.h>
+#endif
+
+namespace miutil {
+
+namespace {
+
+inline int lowest_bit(std::uint64_t m)
+{
+  return __builtin_ctzll(m);
+}
+
+std::uint64_t mask64_scalar(const char* block, const char*, int, const std::uint64_t* bits)
+{
+  std::uint64_t m = 0;
+  for (int i=0; i<64; ++i) {
+    const unsigned char u = block[i];
+    m |= ((bits[u >> 6] >> (u & 63)) & 1) << i;
+  }
+  return m;
+}
+
+#ifdef PUTOOLS_CHARSET_X86
+std::uint64_t mask64_sse2(const char* block, const char* chars, int nchars, const std::uint64_t*)
+{
+  std::uint64_t m = 0;
+  for (int b=0; b<4; ++b) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16*b));
+    __m128i hits = _mm_setzero_si128();
+    for (int i=0; i<nchars; ++i)
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8(chars[i])));
+    m |= std::uint64_t(static_cast<std::uint16_t>(_mm_movemask_epi8(hits))) << (16*b);
+  }
+  return m;
+}
+
+__attribute__((target("avx2")))
+std::uint64_t mask64_avx2(const char* block, const char* chars, int nchars, const std::uint64_t*)
+{
+  const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+  __m256i hits0 = _mm256_setzero_si256(), hits1 = _mm256_setzero_si256();
+  for (int i=0; i<nchars; ++i) {
+    const __m256i c = _mm256_set1_epi8(chars[i]);
+    hits0 = _mm256_or_si256(hits0, _mm256_cmpeq_epi8(v0, c));
+    hits1 = _mm256_or_si256(hits1, _mm256_cmpeq_epi8(v1, c));
+  }
+  const std::uint32_t m0 = _mm256_movemask_epi8(hits0);
+  const std::uint32_t m1 = _mm256_movemask_epi8(hits1);
+  return std::uint64_t(m0) | (std::uint64_t(m1) << 32);
+}
+#endif // PUTOOLS_CHARSET_X86
+
+bool engine_supported(CharSet::Engine e)
+{
+  switch (e) {
+  case CharSet::ENGINE_AUTO:
+  case CharSet::ENGINE_SCALAR:
+    return true;
+#ifdef PUTOOLS_CHARSET_X86
+  case CharSet::ENGINE_SSE2:
+    return true;
+  case CharSet::ENGINE_AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+CharSet::Engine best_engine()
+{
+  if (engine_supported(CharSet::ENGINE_AVX2))
+    return CharSet::ENGINE_AVX2;
+  if (engine_supported(CharSet::ENGINE_SSE2))
+    return CharSet::ENGINE_SSE2;
+  return CharSet::ENGINE_SCALAR;
+}
+
+std::atomic<int>& current_engine()
+{
+  static std::atomic<int> engine(best_engine());
+  return engine;
+}
+
+CharSet::mask64_f engine_mask64(CharSet::Engine e)
+{
+#ifdef PUTOOLS_CHARSET_X86
+  if (e == CharSet::ENGINE_AVX2)
+    return mask64_avx2;
+  if (e == CharSet::ENGINE_SSE2)
+    return mask64_sse2;
+#endif
+  return mask64_scalar;
+}
+
+} // namespace
+
+CharSet::CharSet()
+  : bits_{0, 0, 0, 0}
+  , nchars_(0)
+  , mask64_(engine_mask64(engine()))
+{
+}
+
+CharSet::CharSet(const char* chars)
+  : CharSet()
+{
+  if (chars) {
+    for (; *chars; ++chars)
+      add(*chars);
+  }
+}
+
+CharSet::CharSet(std::string_view chars)
+  : CharSet()
+{
+  for (char c : chars)
+    add(c);
+}
+
+void CharSet::add(char c)
+{
+  if (contains(c))
+    return;
+
+  const unsigned char u = c;
+  bits_[u >> 6] |= (std::uint64_t(1) << (u & 63));
+
+  if (nchars_ < MAX_SIMD_CHARS) {
+    chars_[nchars_] = c;
+  } else if (nchars_ == MAX_SIMD_CHARS) {
+    // too many compares, the bitmap lookup is faster
+    mask64_ = mask64_scalar;
+  }
+  nchars_ += 1;
+}
+
+std::uint64_t CharSet::mask(const char* block, std::size_t count) const
+{
+  if (count >= 64)
+    return mask64(block);
+  if (count == 0)
+    return 0;
+
+  char padded[64];
+  std::memcpy(padded, block, count);
+  std::memset(padded + count, 0, 64 - count);
+  return mask64(padded) & ((std::uint64_t(1) << count) - 1);
+}
+
+std::size_t CharSet::find_first_in(std::string_view text, std::size_t pos) const
+{
+  const std::size_t len = text.size();
+  for (; pos + 64 <= len; pos += 64) {
+    const std::uint64_t m = mask64(text.data() + pos);
+    if (m)
+      return pos + lowest_bit(m);
+  }
+  for (; pos < len; ++pos) {
+    if (contains(text[pos]))
+      return pos;
+  }
+  return std::string_view::npos;
+}
+
+std::size_t CharSet::find_first_not_in(std::string_view text, std::size_t pos) const
+{
+  const std::size_t len = text.size();
+  for (; pos + 64 <= len; pos += 64) {
+    const std::uint64_t m = ~mask64(text.data() + pos);
+    if (m)
+      return pos + lowest_bit(m);
+  }
+  for (; pos < len; ++pos) {
+    if (!contains(text[pos]))
+      return pos;
+  }
+  return std::string_view::npos;
+}
+
+std::size_t CharSet::find_last_not_in(std::string_view text) const
+{
+  for (std::size_t pos = text.size(); pos > 0; --pos) {
+    if (!contains(text[pos-1]))
+      return pos-1;
+  }
+  return std::string_view::npos;
+}
+
+// static
+const CharSet& CharSet::whitespace()
+{
+  static const CharSet ws(whitespaces);
+  return ws;
+}
+
+// static
+bool CharSet::selectEngine(Engine e)
+{
+  if (!engine_supported(e))
+    return false;
+  if (e == ENGINE_AUTO)
+    e = best_engine();
+  current_engine() = e;
+  return true;
+}
+
+// static
+CharSet::Engine CharSet::engine()
+{
+  return static_cast<Engine>(current_engine().load());
+}
+
+// ########################################################################
+
+void CharSetScanner::load_block(std::size_t block)
+{
+  block_ = block;
+  const std::size_t start = 64*block;
+  mask_ = set_.mask(text_.data() + start, text_.size() - start);
+}
+
+std::string_view trimmed_view(std::string_view text, const CharSet& wspace)
+{
+  const std::size_t begin = wspace.find_first_not_in(text);
+  if (begin == std::string_view::npos)
+    return std::string_view();
+  const std::size_t end = wspace.find_last_not_in(text) + 1;
+  return text.substr(begin, end - begin);
+}
+
+} // namespace miutil
@@ -0,0 +1,181 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MICHARSET_H
+#define PUTOOLS_MICHARSET_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace miutil {
+
+/**
+ * A set of bytes, used to classify separator and whitespace characters.
+ *
+ * Lookup is a single bit test, which is much cheaper than the
+ * per-character loop over a C string done by std::string::find_first_of.
+ *
+ * For small sets (up to MAX_SIMD_CHARS characters), blocks of 64 bytes
+ * are classified with SSE2 or AVX2 compares, depending on what the CPU
+ * supports at runtime. Larger sets use the bitmap only.
+ */
+class CharSet {
+public:
+  enum Engine {
+    ENGINE_AUTO,   //!< best engine supported by the CPU
+    ENGINE_SCALAR, //!< bitmap lookup only
+    ENGINE_SSE2,
+    ENGINE_AVX2
+  };
+
+  enum { MAX_SIMD_CHARS = 16 };
+
+  CharSet();
+  explicit CharSet(const char* chars);
+  explicit CharSet(std::string_view chars);
+
+  void add(char c);
+
+  bool contains(char c) const
+    { const unsigned char u = c; return ((bits_[u >> 6] >> (u & 63)) & 1) != 0; }
+
+  /**
+   * Classify 64 bytes starting at block, which must all be readable.
+   * \return bitmask with bit i set if block[i] is in the set
+   */
+  std::uint64_t mask64(const char* block) const
+    { return mask64_(block, chars_, nchars_, bits_); }
+
+  /// like mask64, but reads only count <= 64 bytes; higher bits are 0
+  std::uint64_t mask(const char* block, std::size_t count) const;
+
+  /// position of the first character at or after pos that is in the set, or npos
+  std::size_t find_first_in(std::string_view text, std::size_t pos=0) const;
+
+  /// position of the first character at or after pos that is not in the set, or npos
+  std::size_t find_first_not_in(std::string_view text, std::size_t pos=0) const;
+
+  /// position of the last character that is not in the set, or npos
+  std::size_t find_last_not_in(std::string_view text) const;
+
+  /// the set of miutil::whitespaces
+  static const CharSet& whitespace();
+
+  /**
+   * Select the engine used by CharSet objects constructed afterwards.
+   * \return false if the CPU does not support the engine
+   */
+  static bool selectEngine(Engine engine);
+
+  /// the engine used for new CharSet objects, never ENGINE_AUTO
+  static Engine engine();
+
+  typedef std::uint64_t (*mask64_f)(const char* block, const char* chars, int nchars, const std::uint64_t* bits);
+
+private:
+  std::uint64_t bits_[4];
+  char chars_[MAX_SIMD_CHARS];
+  int nchars_;
+  mask64_f mask64_;
+};
+
+/**
+ * Incremental search for characters of a CharSet in a text.
+ *
+ * The bitmask of the current 64-byte block is remembered, so that
+ * consecutive searches, e.g. for token boundaries, mostly work on the
+ * cached mask instead of classifying the same bytes again.
+ */
+class CharSetScanner {
+public:
+  CharSetScanner(const CharSet& set, std::string_view text)
+    : set_(set), text_(text), block_(std::string_view::npos), mask_(0) {}
+
+  const CharSet& charset() const
+    { return set_; }
+
+  /// position of the first character at or after pos that is in the set, or npos
+  std::size_t find_first_in(std::size_t pos)
+    {
+      const std::size_t len = text_.size();
+      while (pos < len) {
+        const std::size_t block = pos / 64;
+        const std::uint64_t m = block_mask(block) >> (pos % 64);
+        if (m)
+          return pos + __builtin_ctzll(m);
+        pos = 64*(block + 1);
+      }
+      return std::string_view::npos;
+    }
+
+  /// position of the first character at or after pos that is not in the set, or npos
+  std::size_t find_first_not_in(std::size_t pos)
+    {
+      const std::size_t len = text_.size();
+      while (pos < len) {
+        const std::size_t block = pos / 64;
+        const std::uint64_t m = ~block_mask(block) >> (pos % 64);
+        if (m) {
+          pos += __builtin_ctzll(m);
+          return (pos < len) ? pos : std::string_view::npos;
+        }
+        pos = 64*(block + 1);
+      }
+      return std::string_view::npos;
+    }
+
+private:
+  std::uint64_t block_mask(std::size_t block)
+    { if (block != block_) load_block(block); return mask_; }
+  void load_block(std::size_t block);
+
+private:
+  CharSet set_;
+  std::string_view text_;
+  std::size_t block_;
+  std::uint64_t mask_;
+};
+
+std::string_view trimmed_view(std::string_view text, const CharSet& wspace);
+
+/// true for the characters in miutil::whitespaces
+inline bool is_whitespace(char c)
+{
+  return c == ' ' || c == '\r' || c == '\t' || c == '\n';
+}
+
+/// returns text without leading and trailing miutil::whitespaces
+inline std::string_view trimmed_view(std::string_view text)
+{
+  if (text.empty() || (!is_whitespace(text.front()) && !is_whitespace(text.back())))
+    return text;
+  return trimmed_view(text, CharSet::whitespace());
+}
+
+} // namespace miutil
+
+#endif // PUTOOLS_MICHARSET_H
@@ -0,0 +1,380 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miCharTransform.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define PUTOOLS_CHARTRANSFORM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace miutil {
+
+namespace {
+const std::size_t npos = std::string_view::npos;
+
+// out <= in, the ranges may overlap; short runs are copied without calling memmove
+inline void copy_run(char*& out, const char* in, std::size_t n)
+{
+  if (n <= 8) {
+    for (std::size_t i=0; i<n; ++i)
+      out[i] = in[i];
+  } else if (out != in) {
+    std::memmove(out, in, n);
+  }
+  out += n;
+}
+
+/**
+ * Move the characters not in chars to the front, working on bitmasks of
+ * 64-byte blocks. If that is not null, each run of characters in chars
+ * is replaced by *that.
+ */
+char* compact(char* first, char* last, const CharSet& chars, const char* that)
+{
+  char* out = first;
+  bool in_run = false;
+  for (const char* in = first; in < last; in += 64) {
+    const std::size_t n = std::min<std::size_t>(last - in, 64);
+    std::uint64_t m = (n == 64) ? chars.mask64(in) : chars.mask(in, n);
+    if (m == 0) {
+      copy_run(out, in, n);
+      in_run = false;
+      continue;
+    }
+    std::size_t start = 0;
+    for (; m; m &= m - 1) {
+      const std::size_t b = __builtin_ctzll(m);
+      if (b > start) {
+        copy_run(out, in + start, b - start);
+        in_run = false;
+      }
+      if (that && !in_run)
+        *out++ = *that;
+      in_run = true;
+      start = b + 1;
+    }
+    if (n > start) {
+      copy_run(out, in + start, n - start);
+      in_run = false;
+    }
+  }
+  return out;
+}
+} // namespace
+
+char* remove_chars(char* first, char* last, const CharSet& chars)
+{
+  return compact(first, last, chars, nullptr);
+}
+
+void replace_chars(char* first, char* last, const CharSet& chars, char that)
+{
+  CharSetScanner scanner(chars, std::string_view(first, last - first));
+  for (std::size_t pos = scanner.find_first_in(0); pos != npos; pos = scanner.find_first_in(pos + 1))
+    first[pos] = that;
+}
+
+char* replace_squeeze(char* first, char* last, const CharSet& chars, char that)
+{
+  return compact(first, last, chars, &that);
+}
+
+void remove_chars(std::string& text, const CharSet& chars)
+{
+  char* first = &text[0];
+  text.resize(remove_chars(first, first + text.size(), chars) - first);
+}
+
+void replace_chars(std::string& text, const CharSet& chars, char that)
+{
+  char* first = &text[0];
+  replace_chars(first, first + text.size(), chars, that);
+}
+
+void replace_squeeze(std::string& text, const CharSet& chars, char that)
+{
+  char* first = &text[0];
+  text.resize(replace_squeeze(first, first + text.size(), chars, that) - first);
+}
+
+// ------------------------------------------------------------------------
+
+CharMap::CharMap()
+{
+  for (int i=0; i<256; ++i)
+    table_[i] = static_cast<char>(i);
+}
+
+CharMap& CharMap::set(const CharSet& from, char to)
+{
+  for (int i=0; i<256; ++i) {
+    if (from.contains(static_cast<char>(i)))
+      table_[i] = to;
+  }
+  return *this;
+}
+
+void CharMap::apply(char* first, char* last) const
+{
+  for (; first != last; ++first)
+    *first = table_[static_cast<unsigned char>(*first)];
+}
+
+// ------------------------------------------------------------------------
+
+namespace {
+
+enum CaseConversion { LOWER_ASCII, UPPER_ASCII, LOWER_LATIN1, UPPER_LATIN1 };
+
+CharMap make_case_map(CaseConversion conversion)
+{
+  const bool lower = (conversion == LOWER_ASCII || conversion == LOWER_LATIN1);
+  const bool latin1 = (conversion == LOWER_LATIN1 || conversion == UPPER_LATIN1);
+  const int from = lower ? 'A' : 'a', to = lower ? 'a' : 'A';
+
+  CharMap map;
+  for (int i=0; i<26; ++i)
+    map.set(from + i, to + i);
+  if (latin1) {
+    // 0xC0-0xDE <-> 0xE0-0xFE, except multiplication and division signs
+    const int lfrom = lower ? 0xC0 : 0xE0, lto = lower ? 0xE0 : 0xC0;
+    for (int i=0; i<31; ++i) {
+      if (i != 0x17)
+        map.set(lfrom + i, lto + i);
+    }
+  }
+  return map;
+}
+
+const CharMap& case_map(CaseConversion conversion)
+{
+  static const CharMap maps[4] = {
+    make_case_map(LOWER_ASCII), make_case_map(UPPER_ASCII),
+    make_case_map(LOWER_LATIN1), make_case_map(UPPER_LATIN1)
+  };
+  return maps[conversion];
+}
+
+#ifdef PUTOOLS_CHARTRANSFORM_X86
+// toggle the case bit of the 26 letters starting at first_letter
+inline __m128i flip_case_sse2(__m128i v, char first_letter)
+{
+  const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first_letter)));
+  const __m128i letter = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+  return _mm_xor_si128(v, _mm_and_si128(letter, _mm_set1_epi8(0x20)));
+}
+#endif // PUTOOLS_CHARTRANSFORM_X86
+
+void convert_case(char* first, char* last, CaseConversion conversion)
+{
+  const CharMap& map = case_map(conversion);
+#ifdef PUTOOLS_CHARTRANSFORM_X86
+  if (CharSet::engine() != CharSet::ENGINE_SCALAR) {
+    const bool lower = (conversion == LOWER_ASCII || conversion == LOWER_LATIN1);
+    const bool latin1 = (conversion == LOWER_LATIN1 || conversion == UPPER_LATIN1);
+    const char first_letter = lower ? 'A' : 'a';
+    for (; last - first >= 16; first += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      if (latin1 && _mm_movemask_epi8(v) != 0) {
+        // non-ASCII bytes in this block, use the table
+        map.apply(first, first + 16);
+      } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first), flip_case_sse2(v, first_letter));
+      }
+    }
+  }
+#endif // PUTOOLS_CHARTRANSFORM_X86
+  map.apply(first, last);
+}
+
+// ------------------------------------------------------------------------
+
+/*
+ * Case mapping for UTF-8 text, limited to characters where both cases
+ * are encoded with two bytes (U+0080 - U+07FF), so that the conversion
+ * can be done in place. The first table level maps the lead byte to a
+ * block of 64 entries, indexed by the continuation byte; block 0 is
+ * used for lead bytes without any mapped characters.
+ */
+class Utf8CaseTable {
+public:
+  explicit Utf8CaseTable(bool lower);
+
+  /// convert the two-byte sequence at p in place
+  void convert(char* p) const
+    {
+      const int block = index_[static_cast<unsigned char>(p[0]) - 0xC0];
+      if (block) {
+        const std::uint16_t m = blocks_[block][static_cast<unsigned char>(p[1]) & 0x3F];
+        p[0] = static_cast<char>(m >> 8);
+        p[1] = static_cast<char>(m & 0xFF);
+      }
+    }
+
+private:
+  void set(std::uint32_t from, std::uint32_t to);
+
+  static std::uint16_t encode(std::uint32_t code_point)
+    { return ((0xC0 | (code_point >> 6)) << 8) | (0x80 | (code_point & 0x3F)); }
+
+private:
+  std::uint8_t index_[32];
+  std::vector<std::array<std::uint16_t, 64>> blocks_;
+};
+
+Utf8CaseTable::Utf8CaseTable(bool lower)
+  : blocks_(1)
+{
+  std::fill(index_, index_ + 32, 0);
+
+  // upper case -> lower case
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+  const auto add_range = [&pairs](std::uint32_t first, std::uint32_t last, std::uint32_t offset, std::uint32_t step) {
+    for (std::uint32_t c = first; c <= last; c += step)
+      pairs.emplace_back(c, c + offset);
+  };
+  add_range(0xC0, 0xD6, 0x20, 1);    // Latin-1 supplement
+  add_range(0xD8, 0xDE, 0x20, 1);
+  pairs.emplace_back(0x178, 0xFF);   // Y with diaeresis
+  add_range(0x100, 0x12E, 1, 2);     // Latin Extended-A, except dotted/dotless i
+  add_range(0x132, 0x136, 1, 2);
+  add_range(0x139, 0x147, 1, 2);
+  add_range(0x14A, 0x176, 1, 2);
+  add_range(0x179, 0x17D, 1, 2);
+  pairs.emplace_back(0x386, 0x3AC);  // Greek
+  add_range(0x388, 0x38A, 0x25, 1);
+  pairs.emplace_back(0x38C, 0x3CC);
+  add_range(0x38E, 0x38F, 0x3F, 1);
+  add_range(0x391, 0x3A1, 0x20, 1);
+  add_range(0x3A3, 0x3AB, 0x20, 1);
+  add_range(0x400, 0x40F, 0x50, 1);  // Cyrillic
+  add_range(0x410, 0x42F, 0x20, 1);
+
+  for (const auto& p : pairs) {
+    if (lower)
+      set(p.first, p.second);
+    else
+      set(p.second, p.first);
+  }
+  if (!lower)
+    set(0x3C2, 0x3A3); // final sigma
+}
+
+void Utf8CaseTable::set(std::uint32_t from, std::uint32_t to)
+{
+  const int lead = from >> 6;
+  std::uint8_t& block = index_[lead];
+  if (block == 0) {
+    block = blocks_.size();
+    blocks_.emplace_back();
+    for (int i=0; i<64; ++i)
+      blocks_.back()[i] = encode((lead << 6) | i);
+  }
+  blocks_[block][from & 0x3F] = encode(to);
+}
+
+const Utf8CaseTable& utf8_case_table(bool lower)
+{
+  static const Utf8CaseTable tables[2] = { Utf8CaseTable(false), Utf8CaseTable(true) };
+  return tables[lower ? 1 : 0];
+}
+
+void convert_case_utf8(char* first, char* last, bool lower)
+{
+  const CharMap& ascii = case_map(lower ? LOWER_ASCII : UPPER_ASCII);
+  const Utf8CaseTable& table = utf8_case_table(lower);
+#ifdef PUTOOLS_CHARTRANSFORM_X86
+  const bool simd = (CharSet::engine() != CharSet::ENGINE_SCALAR);
+  const char first_letter = lower ? 'A' : 'a';
+#endif
+  while (first < last) {
+#ifdef PUTOOLS_CHARTRANSFORM_X86
+    if (simd) {
+      for (; last - first >= 16; first += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        if (_mm_movemask_epi8(v) != 0)
+          break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first), flip_case_sse2(v, first_letter));
+      }
+      if (first == last)
+        break;
+    }
+#endif // PUTOOLS_CHARTRANSFORM_X86
+    const unsigned char c = *first;
+    if (c < 0x80) {
+      *first = ascii(*first);
+      first += 1;
+    } else if (c >= 0xC0 && c < 0xE0 && last - first >= 2 && (first[1] & 0xC0) == 0x80) {
+      table.convert(first);
+      first += 2;
+    } else {
+      // longer sequences and invalid bytes are not changed
+      first += 1;
+    }
+  }
+}
+
+} // namespace
+
+void to_lower_inplace(char* first, char* last)
+{
+  convert_case(first, last, LOWER_ASCII);
+}
+
+void to_upper_inplace(char* first, char* last)
+{
+  convert_case(first, last, UPPER_ASCII);
+}
+
+void to_lower_latin1_inplace(char* first, char* last)
+{
+  convert_case(first, last, LOWER_LATIN1);
+}
+
+void to_upper_latin1_inplace(char* first, char* last)
+{
+  convert_case(first, last, UPPER_LATIN1);
+}
+
+void to_lower_utf8_inplace(char* first, char* last)
+{
+  convert_case_utf8(first, last, true);
+}
+
+void to_upper_utf8_inplace(char* first, char* last)
+{
+  convert_case_utf8(first, last, false);
+}
+
+} // namespace miutil
@@ -0,0 +1,102 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MICHARTRANSFORM_H
+#define PUTOOLS_MICHARTRANSFORM_H
+
+#include "miCharSet.h"
+
+#include <string>
+
+namespace miutil {
+
+/**
+ * In-place character transforms working in a single pass.
+ *
+ * The kernels on [first, last) classify 64-byte blocks with CharSet
+ * bitmasks and move the kept text in runs, so the cost is linear in
+ * the length of the text, also when many characters are affected.
+ */
+
+/// remove all characters in chars from [first, last); returns the new end
+char* remove_chars(char* first, char* last, const CharSet& chars);
+
+/// replace all characters in chars by that
+void replace_chars(char* first, char* last, const CharSet& chars, char that);
+
+/// replace each run of characters in chars by a single that; returns the new end
+char* replace_squeeze(char* first, char* last, const CharSet& chars, char that);
+
+void remove_chars(std::string& text, const CharSet& chars);
+void replace_chars(std::string& text, const CharSet& chars, char that);
+void replace_squeeze(std::string& text, const CharSet& chars, char that);
+
+/**
+ * A 256-entry translation table for characters, starting as identity.
+ */
+class CharMap {
+public:
+  CharMap();
+
+  CharMap& set(char from, char to)
+    { table_[static_cast<unsigned char>(from)] = to; return *this; }
+
+  /// map all characters in from to the same character
+  CharMap& set(const CharSet& from, char to);
+
+  char operator()(char c) const
+    { return table_[static_cast<unsigned char>(c)]; }
+
+  void apply(char* first, char* last) const;
+
+  void apply(std::string& text) const
+    { apply(&text[0], &text[0] + text.size()); }
+
+private:
+  char table_[256];
+};
+
+/// ASCII case conversion of [first, last), other bytes are unchanged
+void to_lower_inplace(char* first, char* last);
+void to_upper_inplace(char* first, char* last);
+
+/// ASCII and ISO 8859-1 case conversion of [first, last)
+void to_lower_latin1_inplace(char* first, char* last);
+void to_upper_latin1_inplace(char* first, char* last);
+
+/**
+ * Case conversion of UTF-8 text in [first, last), for ASCII and the
+ * Latin-1 supplement, Latin Extended-A, Greek and Cyrillic letters
+ * that keep their encoded length. Other sequences and invalid bytes
+ * are not changed.
+ */
+void to_lower_utf8_inplace(char* first, char* last);
+void to_upper_utf8_inplace(char* first, char* last);
+
+} // namespace miutil
+
+#endif // PUTOOLS_MICHARTRANSFORM_H
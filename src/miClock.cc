@@ -37,7 +37,9 @@
 #endif
 
 #include "miClock.h"
+#include "miNumberParse.h"
 #include "miString.h"
+#include "miStringReplace.h"
 
 #include <iostream>
 #include <sstream>
@@ -55,20 +57,20 @@ static inline void warning(const std::string& s)
   std::cerr << "Warning: miClock::" << s << std::endl;
 }
 
-static bool scan_clock(const std::string& str, int& h, int& m, int& s)
+static bool scan_clock(std::string_view str, int& h, int& m, int& s)
 {
   m = s = 0;
   bool bad = true;
   if (str.size() == 8)
-    bad = (sscanf(str.c_str(), "%2d:%2d:%2d", &h, &m, &s) != 3);
+    bad = (miutil::scan_ints(str, "%2d:%2d:%2d", { &h, &m, &s }) != 3);
   else if (str.size() == 6)
-    bad = (sscanf(str.c_str(), "%2d%2d%2d", &h, &m, &s) != 3);
+    bad = (miutil::scan_ints(str, "%2d%2d%2d", { &h, &m, &s }) != 3);
   else if (str.size() == 5)
-    bad = (sscanf(str.c_str(), "%2d:%2d", &h, &m) != 2);
+    bad = (miutil::scan_ints(str, "%2d:%2d", { &h, &m }) != 2);
   else if (str.size() == 4)
-    bad = (sscanf(str.c_str(), "%2d%2d", &h, &m) != 2);
+    bad = (miutil::scan_ints(str, "%2d%2d", { &h, &m }) != 2);
   else if (str.size() == 2)
-    bad = (sscanf(str.c_str(), "%2d", &h) != 1);
+    bad = (miutil::scan_ints(str, "%2d", { &h }) != 1);
   if (!bad)
     return true;
   h = m = s = -2;
@@ -109,13 +111,13 @@ miutil::miClock::setClock(int h, int m, int s)
 
 // converts "hh:mm:ss" to miClock
 void
-miutil::miClock::setClock(const std::string& str)
+miutil::miClock::setClock(std::string_view str)
 {
   int h, m, s;
   scan_clock(str, h, m, s);
   setClock(h,m,s);
   if (undef())
-    warning(str);
+    warning(std::string(str));
 }
 
 bool
@@ -128,7 +130,7 @@ miutil::miClock::isValid(int h, int m, int s)
 }
 
 bool
-miutil::miClock::isValid(const std::string& str)
+miutil::miClock::isValid(std::string_view str)
 {
   int h, m, s;
   if (!scan_clock(str, h, m, s))
@@ -140,41 +142,36 @@ miutil::miClock::isValid(const std::string& str)
 std::string
 miutil::miClock::isoClock() const
 {
-  ostringstream ost;
-
-  if (undef()) {
-    warning("isoClock: undefined time");
-    ost << "--:--:--";
-  }
-  else
-    ost << setw(2) << setfill('0') << Hour << ':'
-	<< setw(2) << setfill('0') << Min  << ':'
-	<< setw(2) << setfill('0') << Sec;
-
-  return ost.str();
+  return isoClock(true, true);
 }
 
 // Format 'almost' ISO "hh[:mm:ss]" string
 std::string
 miutil::miClock::isoClock(bool withmin, bool withsec) const
 {
-  ostringstream ost;
-
   if (withsec && !withmin) withmin= true;
 
   if (undef()) {
     warning("isoClock: undefined time");
-    ost << "--";
-    if (withmin) ost << ":--";
-    if (withsec) ost << ":--";
-  }
-  else {
-    ost << setw(2) << setfill('0') << Hour;
-    if (withmin) ost << ':' << setw(2) << setfill('0') << Min;
-    if (withsec) ost << ':' << setw(2) << setfill('0') << Sec;
+    if (withsec)
+      return "--:--:--";
+    if (withmin)
+      return "--:--";
+    return "--";
   }
 
-  return ost.str();
+  char buffer[48];
+  char* const end = buffer + sizeof(buffer);
+  char* p = miutil::format_number(buffer, end, Hour, 2);
+  if (withmin) {
+    *p++ = ':';
+    p = miutil::format_number(p, end, Min, 2);
+  }
+  if (withsec) {
+    *p++ = ':';
+    p = miutil::format_number(p, end, Sec, 2);
+  }
+  return std::string(buffer, p);
 }
 
 void
@@ -252,43 +249,85 @@ miutil::miClock::oclock()
   return miClock(curTime->tm_hour, curTime->tm_min, curTime->tm_sec);
 }
 
-std::string
-miutil::miClock::format(const std::string& newClock) const
-{
-  if(undef())
-    return newClock;
-
-
-  bool pm = (Hour < 1 || Hour > 12 ? true : false );
-
-  int tH =  ( Hour ? Hour : 24 ) - (pm ? 12 : 0);
-
-  std::string c(newClock);
+namespace {
+enum ClockFormatPattern {
+  CF_X, CF_T, CF_r, CF_H, CF_I, CF_k, CF_l, CF_M, CF_p, CF_S, CF_30M,
+  CF_midnight24_before, CF_midnight24_after, CF_midnight24
+};
 
-  miutil::replace(c, "%X","%H:%M:%S");         /// %X 24-hour (hh:mm:ss)
-  miutil::replace(c, "%T","%H:%M:%S");         /// %X 24-hour (hh:mm:ss)
-  miutil::replace(c, "%r","%I:%M:%S %p");      /// %r 12-hour (hh:mm:ss [AP]M)
+const miutil::Replacer& clock_format_patterns()
+{
+  static const miutil::Replacer patterns({
+      "%X",  /// %X 24-hour (hh:mm:ss)
+      "%T",  /// %T 24-hour (hh:mm:ss)
+      "%r",  /// %r 12-hour (hh:mm:ss [AP]M)
+      "%H",  /// %H hour (00..23)
+      "%I",  /// %I hour (01..12)
+      "%k",  /// %k hour ( 0..23)
+      "%l",  /// %l hour ( 1..12)
+      "%M",  /// %M min  (00..59)
+      "%p",  /// %p locale's AM or PM
+      "%S",  /// %S second (00..60)
+      "$30M", /// SIGMET SPECIAL
+      " $midnight24", /// show midnight as 24:00:00
+      "$midnight24 ",
+      "$midnight24",
+  });
+  return patterns;
+}
 
-  if (miutil::contains(c, "$midnight24")){   /// show midnight as 24:00:00
-    miutil::replace(c, "%H","24");
-    miutil::replace(c, "%k","24");
-    miutil::replace(c, " $midnight24","");
-    miutil::replace(c, "$midnight24 ","");
-    miutil::replace(c, "$midnight24","");
-  }
+struct ClockFormatter {
+  int hour, min, sec;
+  bool midnight24;
 
-  miutil::replace(c, "%H", miutil::from_number(Hour,2));   /// %H hour (00..23)
-  miutil::replace(c, "%I", miutil::from_number(tH,2));     /// %I hour (01..12)
-  miutil::replace(c, "%k", miutil::from_number(Hour));     /// %k hour ( 0..23)
-  miutil::replace(c, "%l", miutil::from_number(tH));       /// %l hour ( 1..12)
-  miutil::replace(c, "%M", miutil::from_number(Min,2));    /// %M min  (00..59)
+  void operator()(int pattern, std::string& out) const;
+};
 
-  if(miutil::contains(c, "$30M") ){
-    miutil::replace(c, "$30M", (Min < 30 ? "00" : "30" )); /// SIGMET SPECIAL
+void ClockFormatter::operator()(int pattern, std::string& out) const
+{
+  const bool pm = (hour < 1 || hour > 12);
+  const int tH = (hour ? hour : 24) - (pm ? 12 : 0);
+
+  switch (pattern) {
+  case CF_X:
+  case CF_T:
+    clock_format_patterns().replace("%H:%M:%S", out, *this);
+    break;
+  case CF_r:
+    clock_format_patterns().replace("%I:%M:%S %p", out, *this);
+    break;
+  case CF_H:
+    if (midnight24)
+      out += "24";
+    else
+      miutil::append_number(out, hour, 2);
+    break;
+  case CF_I: miutil::append_number(out, tH, 2); break;
+  case CF_k:
+    if (midnight24)
+      out += "24";
+    else
+      miutil::append_number(out, hour);
+    break;
+  case CF_l: miutil::append_number(out, tH); break;
+  case CF_M: miutil::append_number(out, min, 2); break;
+  case CF_p: out += (pm ? "PM" : "AM"); break;
+  case CF_S: miutil::append_number(out, sec, 2); break;
+  case CF_30M: out += (min < 30 ? "00" : "30"); break;
+  default: break; // $midnight24 is removed
   }
+}
+} // namespace
 
-  miutil::replace(c, "%p",(pm ? "PM" : "AM")); /// %p locale's AM or PM
-  miutil::replace(c, "%S", miutil::from_number(Sec,2));    /// %S second (00..60)
+std::string
+miutil::miClock::format(const std::string& newClock) const
+{
+  if(undef())
+    return newClock;
 
+  const ClockFormatter formatter = { Hour, Min, Sec, miutil::contains(newClock, "$midnight24") };
+  std::string c;
+  c.reserve(newClock.size() + 16);
+  clock_format_patterns().replace(newClock, c, formatter);
   return c;
 }
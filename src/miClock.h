@@ -41,6 +41,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 namespace miutil{
 
@@ -60,19 +61,17 @@ class miClock {
 public:
   miClock(int h =-1,int m =-1,int s =-1)  // (-1,-1,-1) is the undef state
   { setClock(h,m,s); }
-  explicit miClock(const char* s)     // construct clock time from "hh:mm:ss"
-  { setClock(s); }
-  explicit miClock(const std::string& s) // ---------------"-------------------
+  explicit miClock(std::string_view s) // construct clock time from "hh:mm:ss"
   { setClock(s); }
 
   bool undef() const
   { return (accSec==-3661); }
 
   static bool isValid(int, int, int);
-  static bool isValid(const std::string&);
+  static bool isValid(std::string_view);
 
   void setClock(int, int, int);
-  void setClock(const std::string&);
+  void setClock(std::string_view);
 
   int hour() const
   { return Hour; }
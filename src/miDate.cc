@@ -34,7 +34,10 @@
 
 #include "miDate.h"
 
+#include "miCharTransform.h"
+#include "miNumberParse.h"
 #include "miString.h"
+#include "miStringReplace.h"
 
 #include <iostream>
 #include <sstream>
@@ -232,8 +235,6 @@ miDate::Translations_cp miDate::language(const std::string& l)
 
   if (!l.empty()) {
     translations_t::const_iterator it = translations.find(l);
-    if (it == translations.end())
-      it = translations.find(miutil::to_lower(l));
     if (it != translations.end())
       return it->second;
   }
@@ -262,13 +263,13 @@ static inline long lfloor(const long a, const long b) // assumes b positive
 static inline int isLeap(const int y)
 { return ((y%4==0 && y%100!=0) || y%400==0); }
 
-static bool scan_date(const std::string& str, int& y, int& m, int& d)
+static bool scan_date(std::string_view str, int& y, int& m, int& d)
 {
   int n = -1;
   if (str.size() == 4 + 1 + 2 + 1 + 2)
-    n = sscanf(str.c_str(), "%4d-%2d-%2d", &y, &m, &d);
+    n = miutil::scan_ints(str, "%4d-%2d-%2d", { &y, &m, &d });
   else if (str.size() == 4 + 2 + 2)
-    n = sscanf(str.c_str(), "%4d%2d%2d", &y, &m, &d);
+    n = miutil::scan_ints(str, "%4d%2d%2d", { &y, &m, &d });
   if (n == 3)
     return true;
   y = m = d = 0;
@@ -310,7 +311,7 @@ miutil::miDate::setDate(int y, int m, int d)
 }
 
 void
-miutil::miDate::setDate(const std::string& str)
+miutil::miDate::setDate(std::string_view str)
 {
   int y, m, d;
   scan_date(str, y, m, d);
@@ -328,7 +329,7 @@ miutil::miDate::isValid(int y, int m, int d)
 }
 
 bool
-miutil::miDate::isValid(const std::string& str)
+miutil::miDate::isValid(std::string_view str)
 {
   int y, m, d;
   if (!scan_date(str, y, m, d))
@@ -423,13 +424,14 @@ miutil::miDate::isoDate() const
   if (undef())
     warning("isoDate: Date is undefined.");
 
-  ostringstream ost;
-
-  ost << setw(4) << setfill('0') << Year  << '-'
-      << setw(2) << setfill('0') << Month << '-'
-      << setw(2) << setfill('0') << Day;
-
-  return ost.str();
+  char buffer[48];
+  char* const end = buffer + sizeof(buffer);
+  char* p = miutil::format_number(buffer, end, Year, 4);
+  *p++ = '-';
+  p = miutil::format_number(p, end, Month, 2);
+  *p++ = '-';
+  p = miutil::format_number(p, end, Day, 2);
+  return std::string(buffer, p);
 }
 
 // Returns the week number. Week 1 of a year is per definition the
@@ -605,33 +607,72 @@ miutil::miDate::format(const std::string& newDate, const std::string& l) const
   return format(newDate, l, false);
 }
 
+namespace {
+void append_lower(std::string& out, const std::string& name, bool utf8)
+{
+  const size_t n = out.size();
+  out += name;
+  char* begin = &out[0];
+  if (utf8)
+    miutil::to_lower_utf8_inplace(begin + n, begin + out.size());
+  else
+    miutil::to_lower_latin1_inplace(begin + n, begin + out.size());
+}
+
+enum DateFormatPattern {
+  DF_y, DF_Y, DF_d, DF_e, DF_m, DF_D, DF_B, DF_b, DF_A, DF_a, DF_V, DF__B, DF__b, DF__A, DF__a
+};
+
+const miutil::Replacer& date_format_patterns()
+{
+  static const miutil::Replacer patterns({
+      "%y", //!%y  last two digits of year (00..99)
+      "%Y", //!%Y  year (1970...)
+      "%d", //!%d  day of month (01..31)
+      "%e", //!%e  day of month ( 1..31)
+      "%m", //!%m  month (01..12)
+      "%D", //!%D  date (yyyy-mm-dd)
+      "%B", //!%B  month  name,  (January..December)
+      "%b", //!%b  short month  name,  (Jan..Dec)
+      "%A", //!%A  weekday name, (Sunday..Saturday)
+      "%a", //!%a  shortweekday name, (Sun..Sat)
+      "%V", //!%V  week number
+      "%_B", //!%B  month  name, lowercase
+      "%_b", //!%b  short month  name, lowercase
+      "%_A", //!%A  weekday name,lowercase
+      "%_a", //!%a  shortweekday name,lowercase
+  });
+  return patterns;
+}
+} // namespace
+
 std::string
 miutil::miDate::format(const std::string& newDate, const std::string& l, bool utf8) const
 {
   if(undef())
     return newDate;
 
-  std::string d(newDate);
-  miutil::replace(d, "%y", miutil::from_number(Year%100, 2)); //!%y  last two digits of year (00..99)
-  miutil::replace(d, "%Y", miutil::from_number(Year, 4));     //!%Y  year (1970...)
-
-  miutil::replace(d, "%d", miutil::from_number(Day,2));      //!%d  day of month (01..31)
-  miutil::replace(d, "%e", miutil::from_number(Day));        //!%e  day of month ( 1..31)
-  miutil::replace(d, "%m", miutil::from_number(Month,2));    //!%m  month (01..12)
-
-  miutil::replace(d, "%D", isoDate());            //!%D  date (yyyy-mm-dd)
-
-  miutil::replace(d, "%B", monthname(l, utf8));         //!%B  month  name,  (January..December)
-  miutil::replace(d, "%b", shortmonthname(l, utf8));    //!%b  short month  name,  (Jan..Dec)
-  miutil::replace(d, "%A", weekday(l, utf8));           //!%A  weekday name, (Sunday..Saturday)
-  miutil::replace(d, "%a", shortweekday(l, utf8));      //!%a  shortweekday name, (Sun..Sat)
-
-  miutil::replace(d, "%V", miutil::from_number(weekNo())); //!%V  week number
-
-  miutil::replace(d, "%_B", miutil::to_lower(monthname(l, utf8)));      //!%B  month  name, lowercase
-  miutil::replace(d, "%_b", miutil::to_lower(shortmonthname(l, utf8))); //!%b  short month  name, lowercase
-  miutil::replace(d, "%_A", miutil::to_lower(weekday(l, utf8)));        //!%A  weekday name,lowercase
-  miutil::replace(d, "%_a", miutil::to_lower(shortweekday(l, utf8)));   //!%a  shortweekday name,lowercase
+  std::string d;
+  d.reserve(newDate.size() + 16);
+  date_format_patterns().replace(newDate, d, [&](int pattern, std::string& out) {
+    switch (pattern) {
+    case DF_y: append_number(out, Year%100, 2); break;
+    case DF_Y: append_number(out, Year, 4); break;
+    case DF_d: append_number(out, Day, 2); break;
+    case DF_e: append_number(out, Day); break;
+    case DF_m: append_number(out, Month, 2); break;
+    case DF_D: out += isoDate(); break;
+    case DF_B: out += monthname(l, utf8); break;
+    case DF_b: out += shortmonthname(l, utf8); break;
+    case DF_A: out += weekday(l, utf8); break;
+    case DF_a: out += shortweekday(l, utf8); break;
+    case DF_V: append_number(out, weekNo()); break;
+    case DF__B: append_lower(out, monthname(l, utf8), utf8); break;
+    case DF__b: append_lower(out, shortmonthname(l, utf8), utf8); break;
+    case DF__A: append_lower(out, weekday(l, utf8), utf8); break;
+    case DF__a: append_lower(out, shortweekday(l, utf8), utf8); break;
+    }
+  });
 
   return d;
 }
@@ -50,10 +50,13 @@
 #ifndef __dnmi_miDate__
 #define __dnmi_miDate__
 
+#include "miStringCompare.h"
+
 #include <iosfwd>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace miutil{
 
@@ -80,13 +83,15 @@ private:
   int intWeekday() const
     { return (((jdn+1)%7)+7)%7; }
 
-  typedef std::map<std::string, miDate::Translations_cp> translations_t;
+  typedef std::map<std::string, miDate::Translations_cp, iless> translations_t;
   static translations_t translations;
   static void initTranslations();
   static Translations_cp defaultLanguage;
-  static Translations_cp language(const std::string& l);
 
 public:
+  /// translations for language l, the default language if l is empty or unknown
+  static Translations_cp language(const std::string& l);
+
   enum lang {
     English,
     Norwegian
@@ -106,21 +111,19 @@ public:
 
   miDate(int y =0, int m =0, int d =0)
     { setDate(y,m,d); }
-  explicit miDate(const char* s)
-    { setDate(s); }
-  explicit miDate(const std::string& s)
+  explicit miDate(std::string_view s)
     { setDate(s); }
 
   bool undef() const
     { return jdn==0; }
 
   void setDate(int, int, int);
-  void setDate(const std::string&);
+  void setDate(std::string_view);
 
 
   //IS THIS THREADSAFE
   static bool isValid(int, int, int);
-  static bool isValid(const std::string&);
+  static bool isValid(std::string_view);
 
   int year() const
     { return Year; }
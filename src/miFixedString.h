@@ -0,0 +1,219 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+
+#ifndef PUTOOLS_MIFIXEDSTRING_H
+#define PUTOOLS_MIFIXEDSTRING_H
+
+#include "miCharTransform.h"
+#include "miStringSplit.h"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace miutil {
+
+/**
+ * String of at most N characters, stored inline and padded with '\0'.
+ *
+ * Meant for short codes like WMO station numbers, ICAO identifiers or
+ * parameter abbreviations in large arrays of records: sizeof is N, it
+ * never allocates and it is trivially copyable, so records can be
+ * copied with memcpy and sorted without following pointers. It cannot
+ * contain '\0' characters.
+ *
+ * Text that is too long is cut after N characters; assign reports this.
+ * Comparison orders like std::string.
+ */
+template<std::size_t N>
+class FixedString {
+public:
+  typedef const char* const_iterator;
+
+  FixedString()
+    : data_() {}
+
+  /// construct from text, cut after N characters
+  explicit FixedString(std::string_view text)
+    : data_() { assign(text); }
+
+  /**
+   * Replace the contents with text.
+   * \return false if text was longer than N and has been cut
+   */
+  bool assign(std::string_view text)
+    {
+      const std::size_t n = text.size() < N ? text.size() : N;
+      std::memcpy(data_, text.data(), n);
+      std::memset(data_ + n, 0, N - n);
+      return n == text.size();
+    }
+
+  static constexpr std::size_t capacity()
+    { return N; }
+
+  std::size_t size() const
+    { const void* z = std::memchr(data_, 0, N); return z ? static_cast<const char*>(z) - data_ : N; }
+  bool empty() const
+    { return data_[0] == 0; }
+  void clear()
+    { std::memset(data_, 0, N); }
+
+  /// the characters, not terminated by '\0' if size() == N
+  const char* data() const
+    { return data_; }
+  char* data()
+    { return data_; }
+
+  char operator[](std::size_t i) const
+    { return data_[i]; }
+
+  const_iterator begin() const
+    { return data_; }
+  const_iterator end() const
+    { return data_ + size(); }
+
+  std::string_view view() const
+    { return std::string_view(data_, size()); }
+  operator std::string_view() const
+    { return view(); }
+  std::string str() const
+    { return std::string(data_, size()); }
+
+  /// same value as std::hash<std::string_view> of the text
+  std::size_t hash() const
+    { return std::hash<std::string_view>()(view()); }
+
+  bool operator==(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) == 0; }
+  bool operator!=(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) != 0; }
+  bool operator<(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) < 0; }
+  bool operator>(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) > 0; }
+  bool operator<=(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) <= 0; }
+  bool operator>=(const FixedString& other) const
+    { return std::memcmp(data_, other.data_, N) >= 0; }
+
+  bool operator==(std::string_view other) const
+    { return view() == other; }
+  bool operator!=(std::string_view other) const
+    { return view() != other; }
+
+private:
+  char data_[N];
+};
+
+template<std::size_t N>
+inline bool operator==(std::string_view a, const FixedString<N>& b)
+{ return b == a; }
+
+template<std::size_t N>
+inline bool operator!=(std::string_view a, const FixedString<N>& b)
+{ return b != a; }
+
+template<std::size_t N>
+std::ostream& operator<<(std::ostream& out, const FixedString<N>& s)
+{ return out << s.view(); }
+
+/// removes leading and/or trailing characters from wspace
+template<std::size_t N>
+void trim(FixedString<N>& text, bool left=true, bool right=true, const char* wspace=whitespaces)
+{
+  std::string_view v = text.view();
+  if (left) {
+    while (!v.empty() && std::strchr(wspace, v.front()))
+      v.remove_prefix(1);
+  }
+  if (right) {
+    while (!v.empty() && std::strchr(wspace, v.back()))
+      v.remove_suffix(1);
+  }
+  if (v.size() != text.size()) {
+    std::memmove(text.data(), v.data(), v.size());
+    std::memset(text.data() + v.size(), 0, N - v.size());
+  }
+}
+
+template<std::size_t N>
+FixedString<N> trimmed(FixedString<N> text, bool left=true, bool right=true, const char* wspace=whitespaces)
+{ trim(text, left, right, wspace); return text; }
+
+/// ASCII case conversion
+template<std::size_t N>
+void to_lower_inplace(FixedString<N>& text)
+{ to_lower_inplace(text.data(), text.data() + text.size()); }
+
+template<std::size_t N>
+void to_upper_inplace(FixedString<N>& text)
+{ to_upper_inplace(text.data(), text.data() + text.size()); }
+
+template<std::size_t N>
+FixedString<N> to_lower(FixedString<N> text)
+{ to_lower_inplace(text); return text; }
+
+template<std::size_t N>
+FixedString<N> to_upper(FixedString<N> text)
+{ to_upper_inplace(text); return text; }
+
+/**
+ * Store the tokens that miutil::split(text, separator_chars, clean)
+ * would return in fields, at most count of them; tokens are cut after
+ * N characters.
+ *
+ * \return the number of tokens stored
+ */
+template<std::size_t N>
+std::size_t split_into(FixedString<N>* fields, std::size_t count, std::string_view text,
+    const char* separator_chars=whitespaces, bool clean=true)
+{
+  SplitViews splitter(text, 0, separator_chars, clean);
+  std::size_t n = 0;
+  for (std::string_view token; n < count && splitter.next(token); ++n)
+    fields[n].assign(token);
+  return n;
+}
+
+} // namespace miutil
+
+namespace std {
+template<std::size_t N>
+struct hash<miutil::FixedString<N>> {
+  std::size_t operator()(const miutil::FixedString<N>& s) const
+    { return s.hash(); }
+};
+} // namespace std
+
+#endif // PUTOOLS_MIFIXEDSTRING_H
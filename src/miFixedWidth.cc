@@ -0,0 +1,149 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miFixedWidth.h"
+
+#include "miNumberParse.h"
+
+#include <algorithm>
+
+namespace miutil {
+
+namespace {
+inline bool is_blank(char c)
+{
+  return c == ' ' || c == '\t';
+}
+
+std::string_view strip_blanks(std::string_view text)
+{
+  while (!text.empty() && is_blank(text.front()))
+    text.remove_prefix(1);
+  while (!text.empty() && is_blank(text.back()))
+    text.remove_suffix(1);
+  return text;
+}
+} // namespace
+
+FixedWidthLayout::FixedWidthLayout()
+  : record_length_(0)
+  , nints_(0)
+  , ndoubles_(0)
+  , ntexts_(0)
+{
+}
+
+bool FixedWidthLayout::add(const std::string& name, std::size_t offset, std::size_t width, Type type)
+{
+  if (width == 0 || (type == DIGITS && width > 9) || index(name) >= 0)
+    return false;
+
+  std::size_t column;
+  if (type == DIGITS || type == INT)
+    column = nints_++;
+  else if (type == DOUBLE)
+    column = ndoubles_++;
+  else
+    column = ntexts_++;
+  fields_.push_back(Field{ name, offset, width, type, column });
+  record_length_ = std::max(record_length_, offset + width);
+  return true;
+}
+
+int FixedWidthLayout::index(std::string_view name) const
+{
+  for (std::size_t i=0; i<fields_.size(); ++i) {
+    if (fields_[i].name == name)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+// ------------------------------------------------------------------------
+
+FixedWidthColumns::FixedWidthColumns(const FixedWidthLayout& layout)
+  : layout_(layout)
+  , ints_(layout.int_columns())
+  , doubles_(layout.double_columns())
+  , texts_(layout.text_columns())
+  , size_(0)
+{
+}
+
+void FixedWidthColumns::clear()
+{
+  for (std::vector<int>& c : ints_)
+    c.clear();
+  for (std::vector<double>& c : doubles_)
+    c.clear();
+  for (TokenBuffer& c : texts_)
+    c.clear();
+  size_ = 0;
+}
+
+bool FixedWidthColumns::add(std::string_view record)
+{
+  bool ok = true;
+  for (std::size_t i=0; i<layout_.size(); ++i) {
+    const FixedWidthLayout::Field& f = layout_.field(i);
+    const std::string_view text = (f.offset < record.size())
+        ? record.substr(f.offset, f.width) : std::string_view();
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    switch (f.type) {
+    case FixedWidthLayout::DIGITS: {
+      int v = undefined_int;
+      if (text.size() != f.width || !parse_digits(begin, end, v))
+        ok = false;
+      ints_[f.column].push_back(v);
+      break; }
+    case FixedWidthLayout::INT: {
+      const std::string_view s = strip_blanks(text);
+      int v = undefined_int;
+      if (!parse_digits(s.data(), s.data() + s.size(), v) && !parse_number(s.data(), s.data() + s.size(), v))
+        ok = false;
+      ints_[f.column].push_back(v);
+      break; }
+    case FixedWidthLayout::DOUBLE: {
+      // without blanks, plain decimals take the fast path of parse_number
+      const std::string_view s = strip_blanks(text);
+      double v = NAN;
+      if (!parse_number(s.data(), s.data() + s.size(), v))
+        ok = false;
+      doubles_[f.column].push_back(v);
+      break; }
+    case FixedWidthLayout::TEXT:
+      texts_[f.column].push_back(strip_blanks(text));
+      break;
+    }
+  }
+  size_ += 1;
+  return ok;
+}
+
+} // namespace miutil
@@ -0,0 +1,156 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PUTOOLS_MIFIXEDWIDTH_H
+#define PUTOOLS_MIFIXEDWIDTH_H
+
+#include "miStringSplit.h"
+
+#include <climits>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miutil {
+
+/**
+ * Layout of fixed-column records, e.g. SYNOP-style bulletins or
+ * station lists: name, offset, width and type of each field.
+ *
+ * A field that extends beyond the end of a record is cut at the end of
+ * the record, so that records with trailing blanks removed can be read.
+ */
+class FixedWidthLayout {
+public:
+  enum Type {
+    DIGITS, //!< exactly width digits, at most 9, like the time fields read by TimeFilter
+    INT,    //!< integer, with optional sign and blanks
+    DOUBLE, //!< number as accepted by parse_number
+    TEXT    //!< text, without leading and trailing blanks
+  };
+
+  struct Field {
+    std::string name;
+    std::size_t offset;
+    std::size_t width;
+    Type type;
+    std::size_t column; //!< index among the fields stored in the same type of array
+  };
+
+  FixedWidthLayout();
+
+  /**
+   * Add a field. DIGITS and INT fields are stored as int, DOUBLE fields
+   * as double and TEXT fields in a TokenBuffer.
+   * \return false if the field is invalid (width 0, DIGITS wider than 9,
+   *         or a name that is already used), nothing is added then
+   */
+  bool add(const std::string& name, std::size_t offset, std::size_t width, Type type);
+
+  std::size_t size() const
+    { return fields_.size(); }
+
+  const Field& field(std::size_t i) const
+    { return fields_[i]; }
+
+  /// index of the field with this name, or -1
+  int index(std::string_view name) const;
+
+  /// end of the last field
+  std::size_t record_length() const
+    { return record_length_; }
+
+  std::size_t int_columns() const
+    { return nints_; }
+  std::size_t double_columns() const
+    { return ndoubles_; }
+  std::size_t text_columns() const
+    { return ntexts_; }
+
+private:
+  std::vector<Field> fields_;
+  std::size_t record_length_;
+  std::size_t nints_;
+  std::size_t ndoubles_;
+  std::size_t ntexts_;
+};
+
+/**
+ * Values of fixed-width records, stored as one array per field
+ * ("struct of arrays").
+ *
+ * Fields are converted directly from the record text, without
+ * intermediate strings. Invalid numbers are stored as undefined_int or
+ * NAN, like to_int and to_double do.
+ */
+class FixedWidthColumns {
+public:
+  enum { undefined_int = INT_MIN };
+
+  explicit FixedWidthColumns(const FixedWidthLayout& layout);
+
+  const FixedWidthLayout& layout() const
+    { return layout_; }
+
+  /// remove all records, but keep the allocated memory
+  void clear();
+
+  /// number of records
+  std::size_t size() const
+    { return size_; }
+
+  /**
+   * Extract all fields of one record.
+   * \return false if a number field was blank or invalid; the record is added anyway
+   */
+  bool add(std::string_view record);
+
+  /// values of the DIGITS or INT field with index field
+  const std::vector<int>& ints(std::size_t field) const
+    { return ints_[layout_.field(field).column]; }
+
+  /// values of the DOUBLE field with index field
+  const std::vector<double>& doubles(std::size_t field) const
+    { return doubles_[layout_.field(field).column]; }
+
+  /// values of the TEXT field with index field
+  const TokenBuffer& texts(std::size_t field) const
+    { return texts_[layout_.field(field).column]; }
+
+private:
+  FixedWidthLayout layout_;
+  std::vector<std::vector<int>> ints_;
+  std::vector<std::vector<double>> doubles_;
+  std::vector<TokenBuffer> texts_;
+  std::size_t size_;
+};
+
+} // namespace miutil
+
+#endif // PUTOOLS_MIFIXEDWIDTH_H
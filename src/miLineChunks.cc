@@ -0,0 +1,112 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miLineChunks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace miutil {
+
+std::vector<std::string_view> split_line_chunks(std::string_view text, std::size_t count)
+{
+  std::vector<std::string_view> chunks;
+  if (text.empty())
+    return chunks;
+  count = std::max<std::size_t>(count, 1);
+  const std::size_t size = (text.size() + count - 1) / count;
+  chunks.reserve(count);
+  while (!text.empty()) {
+    std::size_t end = text.size();
+    if (size < text.size()) {
+      // extend the chunk to the end of the line
+      const std::size_t nl = text.find('\n', size - 1);
+      if (nl != std::string_view::npos)
+        end = nl + 1;
+    }
+    chunks.push_back(text.substr(0, end));
+    text.remove_prefix(end);
+  }
+  return chunks;
+}
+
+unsigned default_thread_count()
+{
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void run_parallel(std::size_t count, unsigned threads, const std::function<void(std::size_t)>& task)
+{
+  if (threads == 0)
+    threads = default_thread_count();
+  threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+  if (threads <= 1) {
+    for (std::size_t i=0; i<count; ++i)
+      task(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  const auto work = [&]() {
+    for (std::size_t i; (i = next.fetch_add(1)) < count; ) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error)
+          error = std::current_exception();
+        next = count; // skip the remaining tasks
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  try {
+    for (unsigned t=1; t<threads; ++t)
+      workers.emplace_back(work);
+  } catch (...) {
+    // a thread could not be started; stop and join the ones that were
+    next = count;
+    for (std::thread& w : workers)
+      w.join();
+    throw;
+  }
+  work(); // the calling thread works, too
+  for (std::thread& w : workers)
+    w.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace miutil
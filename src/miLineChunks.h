@@ -0,0 +1,121 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PUTOOLS_MILINECHUNKS_H
+#define PUTOOLS_MILINECHUNKS_H
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace miutil {
+
+/**
+ * Fetch the first line of text and remove it, including its "\n" or
+ * "\r\n", from text. Follows the conventions of LineReader.
+ * \return false if text is empty
+ */
+inline bool next_line(std::string_view& text, std::string_view& line)
+{
+  if (text.empty())
+    return false;
+  const char* nl = static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+  const std::size_t end = nl ? (nl - text.data()) : text.size();
+  line = text.substr(0, end);
+  if (!line.empty() && line.back() == '\r')
+    line.remove_suffix(1);
+  text.remove_prefix(nl ? end + 1 : end);
+  return true;
+}
+
+/**
+ * Cut text into at most count chunks of about the same size. Chunks
+ * consist of whole lines: each chunk except the last ends with '\n'.
+ * Concatenating the chunks gives text.
+ */
+std::vector<std::string_view> split_line_chunks(std::string_view text, std::size_t count);
+
+/// std::thread::hardware_concurrency(), or 1 if that is unknown
+unsigned default_thread_count();
+
+/**
+ * Call task(i) for all i in [0, count) on up to threads threads
+ * (0 = default_thread_count()), each thread fetching the next i when it
+ * is done with the previous one.
+ *
+ * If task throws, the remaining tasks are skipped and the first
+ * exception is rethrown after all threads have finished. If a thread
+ * cannot be started, the std::system_error is rethrown the same way.
+ */
+void run_parallel(std::size_t count, unsigned threads, const std::function<void(std::size_t)>& task);
+
+/**
+ * Parse the lines of text on several threads.
+ *
+ * text is cut with split_line_chunks into a few chunks per thread, and
+ * parse(std::string_view line, std::vector<T>& out) is called for the
+ * lines of each chunk, in order, with one output vector per chunk. The
+ * vectors are concatenated in input order, so the result is the same as
+ * when calling parse for each line with one vector.
+ *
+ * parse is called from several threads at once and must not modify
+ * shared state without locking.
+ */
+template<class T, class F>
+std::vector<T> parallel_parse_lines(std::string_view text, F parse, unsigned threads=0)
+{
+  enum { CHUNKS_PER_THREAD = 4 }; // lets fast threads take over work from slow ones
+  if (threads == 0)
+    threads = default_thread_count();
+  const std::vector<std::string_view> chunks = split_line_chunks(text, threads * CHUNKS_PER_THREAD);
+
+  std::vector<std::vector<T>> parts(chunks.size());
+  run_parallel(chunks.size(), threads, [&](std::size_t i) {
+      std::string_view rest = chunks[i];
+      for (std::string_view line; next_line(rest, line); )
+        parse(line, parts[i]);
+    });
+
+  if (parts.size() == 1)
+    return std::move(parts.front());
+  std::size_t total = 0;
+  for (const std::vector<T>& p : parts)
+    total += p.size();
+  std::vector<T> results;
+  results.reserve(total);
+  for (std::vector<T>& p : parts)
+    std::move(p.begin(), p.end(), std::back_inserter(results));
+  return results;
+}
+
+} // namespace miutil
+
+#endif // PUTOOLS_MILINECHUNKS_H
@@ -0,0 +1,163 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miLineReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PUTOOLS_LINEREADER_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace miutil {
+
+namespace {
+inline std::string_view without_cr(const char* begin, const char* end)
+{
+  if (end != begin && end[-1] == '\r')
+    --end;
+  return std::string_view(begin, end - begin);
+}
+} // namespace
+
+LineReader::LineReader(const std::string& path, Mode mode, std::size_t block_size)
+  : mapped_(nullptr)
+  , mapped_size_(0)
+  , file_(nullptr)
+  , capacity_(0)
+  , block_size_(std::max<std::size_t>(block_size, 1))
+  , begin_(nullptr)
+  , end_(nullptr)
+  , lines_(0)
+  , eof_(false)
+  , failed_(false)
+{
+  if (mode == MODE_AUTO && map(path))
+    return;
+  file_ = std::fopen(path.c_str(), "rb");
+  if (file_)
+    std::setvbuf(file_, nullptr, _IONBF, 0); // blocks go directly into buffer_
+}
+
+LineReader::~LineReader()
+{
+#ifdef PUTOOLS_LINEREADER_MMAP
+  if (mapped_)
+    munmap(const_cast<char*>(mapped_), mapped_size_);
+#endif
+  if (file_)
+    std::fclose(file_);
+}
+
+bool LineReader::map(const std::string& path)
+{
+#ifdef PUTOOLS_LINEREADER_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void* p = MAP_FAILED;
+  // pipes, devices and empty files cannot be mapped
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    return false;
+  madvise(p, st.st_size, MADV_SEQUENTIAL);
+
+  mapped_ = static_cast<const char*>(p);
+  mapped_size_ = st.st_size;
+  begin_ = mapped_;
+  end_ = mapped_ + mapped_size_;
+  eof_ = true;
+  return true;
+#else
+  (void) path;
+  return false;
+#endif
+}
+
+void LineReader::fill()
+{
+  // keep the incomplete line at the start of the buffer
+  const std::size_t rest = end_ - begin_;
+  if (capacity_ - rest < block_size_) {
+    const std::size_t capacity = std::max(2*capacity_, rest + block_size_);
+    std::unique_ptr<char[]> bigger(new char[capacity]);
+    if (rest)
+      std::memcpy(bigger.get(), begin_, rest);
+    buffer_ = std::move(bigger);
+    capacity_ = capacity;
+  } else if (rest) {
+    std::memmove(buffer_.get(), begin_, rest);
+  }
+
+  const std::size_t want = capacity_ - rest;
+  const std::size_t got = std::fread(buffer_.get() + rest, 1, want, file_);
+  if (got < want) {
+    eof_ = true;
+    failed_ = (std::ferror(file_) != 0);
+  }
+  begin_ = buffer_.get();
+  end_ = begin_ + rest + got;
+}
+
+bool LineReader::next(std::string_view& line)
+{
+  if (!is_open())
+    return false;
+  while (!failed_) {
+    const std::size_t rest = end_ - begin_;
+    if (rest) {
+      if (const char* nl = static_cast<const char*>(std::memchr(begin_, '\n', rest))) {
+        line = without_cr(begin_, nl);
+        begin_ = nl + 1;
+        lines_ += 1;
+        return true;
+      }
+    }
+    if (eof_) {
+      if (!rest)
+        return false;
+      // last line without line ending
+      line = without_cr(begin_, end_);
+      begin_ = end_;
+      lines_ += 1;
+      return true;
+    }
+    fill();
+  }
+  return false;
+}
+
+} // namespace miutil
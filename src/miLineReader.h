@@ -0,0 +1,127 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PUTOOLS_MILINEREADER_H
+#define PUTOOLS_MILINEREADER_H
+
+#include "miStringSplit.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace miutil {
+
+/**
+ * Reads the lines of a file as std::string_view, without copying them
+ * into std::string.
+ *
+ * Regular files are memory-mapped if the platform supports it. Other
+ * files, and all files with MODE_READ, are read in large blocks into a
+ * buffer that grows if a line does not fit.
+ *
+ * Lines are returned without "\n" or "\r\n". As with std::getline, a
+ * last line without line ending is returned, and there is no empty line
+ * after a final line ending. A line is valid until the next call of
+ * next(); lines of a mapped file stay valid as long as the reader.
+ *
+ * Lines can be passed directly to split_views or for_each_token:
+ * \code
+ * miutil::LineReader reader(path);
+ * for (std::string_view line : reader)
+ *   for (std::string_view token : miutil::split_views(line))
+ *     ...
+ * \endcode
+ */
+class LineReader {
+public:
+  typedef TokenIterator<LineReader> iterator;
+
+  enum Mode {
+    MODE_AUTO, //!< mmap if possible, else read blocks
+    MODE_READ  //!< always read blocks
+  };
+
+  enum { DEFAULT_BLOCK_SIZE = 1 << 20 };
+
+  /// check is_open() to see if the file could be opened
+  explicit LineReader(const std::string& path, Mode mode=MODE_AUTO, std::size_t block_size=DEFAULT_BLOCK_SIZE);
+  ~LineReader();
+
+  LineReader(const LineReader&) = delete;
+  LineReader& operator=(const LineReader&) = delete;
+
+  bool is_open() const
+    { return mapped_ || file_; }
+
+  /// true if the file is memory-mapped
+  bool is_mapped() const
+    { return mapped_ != nullptr; }
+
+  /// true if reading the file failed; next() returns false afterwards
+  bool failed() const
+    { return failed_; }
+
+  /// fetch the next line, returns false at the end of the file
+  bool next(std::string_view& line);
+
+  /// number of lines returned by next() so far
+  std::size_t line_number() const
+    { return lines_; }
+
+  /// the whole file if it is memory-mapped, else empty
+  std::string_view contents() const
+    { return std::string_view(mapped_, mapped_size_); }
+
+  iterator begin()
+    { return iterator(this); }
+  iterator end()
+    { return iterator(); }
+
+private:
+  bool map(const std::string& path);
+  void fill();
+
+private:
+  const char* mapped_;
+  std::size_t mapped_size_;
+  std::FILE* file_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t capacity_;
+  std::size_t block_size_;
+  const char* begin_; //!< start of the unread text
+  const char* end_;   //!< end of the text in memory
+  std::size_t lines_;
+  bool eof_;
+  bool failed_;
+};
+
+} // namespace miutil
+
+#endif // PUTOOLS_MILINEREADER_H
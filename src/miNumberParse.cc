@@ -0,0 +1,493 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miNumberParse.h"
+
+#include "miStringSplit.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+namespace miutil {
+
+namespace {
+
+inline bool is_space(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool is_digit(char c)
+{
+  return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/**
+ * Location of the parts of a number, set by scan_number.
+ */
+struct NumberParts {
+  const char* begin;     //!< first char of the number, after whitespace and '+'
+  const char* int_begin; //!< first char of the integer part
+  const char* int_end;   //!< end of the integer part
+  const char* end;       //!< end of the number, before trailing whitespace
+};
+
+bool scan_number(const char* p, const char* end, NumberParts& parts)
+{
+  while (p != end && is_space(*p))
+    ++p;
+  while (end != p && is_space(end[-1]))
+    --end;
+  if (p == end)
+    return false;
+
+  parts.begin = p;
+  if (*p == '+')
+    parts.begin = ++p; // from_chars does not accept '+'
+  else if (*p == '-')
+    ++p;
+  parts.int_begin = p;
+
+  while (p != end && is_digit(*p))
+    ++p;
+  parts.int_end = p;
+  bool digits = (p != parts.int_begin);
+
+  if (p != end && *p == '.') {
+    const char* frac = ++p;
+    while (p != end && is_digit(*p))
+      ++p;
+    digits |= (p != frac);
+  }
+  if (!digits)
+    return false;
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != end && (*p == '+' || *p == '-'))
+      ++p;
+    const char* exp = p;
+    while (p != end && is_digit(*p))
+      ++p;
+    if (p == exp)
+      return false;
+  }
+
+  parts.end = end;
+  return p == end;
+}
+
+template<typename F>
+bool parse_floating(const char* begin, const char* end, F& value)
+{
+  NumberParts parts;
+  if (!scan_number(begin, end, parts))
+    return false;
+  F v;
+  const std::from_chars_result r = std::from_chars(parts.begin, parts.end, v, std::chars_format::general);
+  if (r.ec != std::errc() || r.ptr != parts.end)
+    return false;
+  value = v;
+  return true;
+}
+
+template<typename I>
+bool parse_integer(const char* begin, const char* end, I& value)
+{
+  NumberParts parts;
+  if (!scan_number(begin, end, parts))
+    return false;
+  if (parts.int_begin == parts.int_end) {
+    // e.g. ".5" or "-.5"
+    value = 0;
+    return true;
+  }
+  I v;
+  const std::from_chars_result r = std::from_chars(parts.begin, parts.int_end, v);
+  if (r.ec != std::errc())
+    return false;
+  value = v;
+  return true;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/**
+ * Convert 8 ASCII digits at once ("SIMD within a register").
+ * \return false if not all 8 chars are digits
+ */
+inline bool parse_8_digits(const char* p, std::uint64_t& value)
+{
+  std::uint64_t chunk;
+  std::memcpy(&chunk, p, 8);
+  // all bytes must be in '0'..'9', i.e. 0x30..0x39
+  if ((((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+          != 0x3333333333333333))
+    return false;
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+  chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFF;
+  value = chunk;
+  return true;
+}
+#else
+inline bool parse_8_digits(const char* p, std::uint64_t& value)
+{
+  std::uint64_t v = 0;
+  for (int i=0; i<8; ++i) {
+    if (!is_digit(p[i]))
+      return false;
+    v = 10*v + (p[i] - '0');
+  }
+  value = v;
+  return true;
+}
+#endif
+
+/// append digits at p to mantissa, 8 at a time while possible
+inline const char* scan_digits(const char* p, const char* end, std::uint64_t& mantissa, int& ndigits)
+{
+  std::uint64_t eight;
+  while (end - p >= 8 && ndigits <= 11 && parse_8_digits(p, eight)) {
+    mantissa = mantissa * 100000000 + eight;
+    ndigits += 8;
+    p += 8;
+  }
+  for (; p != end && is_digit(*p) && ndigits < 19; ++p, ++ndigits)
+    mantissa = 10*mantissa + (*p - '0');
+  return p;
+}
+
+const double exact_powers_of_10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Fast path for plain decimals like "-12.25" without whitespace or exponent.
+ *
+ * If the mantissa and the power of 10 are both exactly representable,
+ * a single division gives the correctly rounded result.
+ *
+ * \return false if the text has to be parsed by parse_number
+ */
+template<typename F>
+bool parse_plain_decimal(const char* p, const char* end, F& value)
+{
+  const bool negative = (p != end && *p == '-');
+  if (p != end && (*p == '-' || *p == '+'))
+    ++p;
+
+  std::uint64_t mantissa = 0;
+  int ndigits = 0;
+  p = scan_digits(p, end, mantissa, ndigits);
+  int nfraction = 0;
+  if (p != end && *p == '.') {
+    const int nint = ndigits;
+    p = scan_digits(p + 1, end, mantissa, ndigits);
+    nfraction = ndigits - nint;
+  }
+  if (p != end || ndigits == 0)
+    return false;
+
+  // double: 53 bit mantissa, 10^22; float: 24 bit mantissa, 10^10
+  const bool is_double = sizeof(F) == sizeof(double);
+  if (mantissa > (std::uint64_t(1) << (is_double ? 53 : 24)) || nfraction > (is_double ? 22 : 10))
+    return false;
+
+  F v = F(mantissa);
+  if (nfraction > 0)
+    v /= F(exact_powers_of_10[nfraction]);
+  value = negative ? -v : v;
+  return true;
+}
+
+// ------------------------------------------------------------------------
+
+/*
+ * DFA for the number grammar. The transitions are defined on a few
+ * character classes and then expanded to a table indexed by state and
+ * byte, so that each input byte costs a single lookup.
+ */
+enum CharClass { C_OTHER, C_SPACE, C_SIGN, C_DIGIT, C_DOT, C_EXP, N_CLASSES };
+
+enum NumberState {
+  S_ERROR,     //!< not a number, absorbing
+  S_START,     //!< leading whitespace
+  S_SIGN,
+  S_INT,       //!< integer digits
+  S_DOT,       //!< '.' without digits before
+  S_FRAC,      //!< '.' after digits, or fraction digits
+  S_EXP,       //!< 'e' or 'E'
+  S_EXP_SIGN,
+  S_EXP_DIGITS,
+  S_TRAIL,     //!< trailing whitespace
+  N_STATES
+};
+
+struct NumberDFA {
+  std::uint8_t next[2][N_STATES][256]; //!< [integer][state][byte]
+  bool accept[2][N_STATES];
+
+  NumberDFA();
+};
+
+NumberDFA::NumberDFA()
+  : next()
+  , accept()
+{
+  std::uint8_t classes[256] = { C_OTHER };
+  for (int c=0; c<256; ++c) {
+    if (is_space(c))
+      classes[c] = C_SPACE;
+    else if (is_digit(c))
+      classes[c] = C_DIGIT;
+  }
+  classes[static_cast<unsigned char>('+')] = classes[static_cast<unsigned char>('-')] = C_SIGN;
+  classes[static_cast<unsigned char>('.')] = C_DOT;
+  classes[static_cast<unsigned char>('e')] = classes[static_cast<unsigned char>('E')] = C_EXP;
+
+  for (int integer=0; integer<2; ++integer) {
+    std::uint8_t t[N_STATES][N_CLASSES] = { { S_ERROR } };
+    t[S_START][C_SPACE] = S_START;
+    t[S_START][C_SIGN] = S_SIGN;
+    t[S_START][C_DIGIT] = t[S_SIGN][C_DIGIT] = S_INT;
+    t[S_INT][C_DIGIT] = S_INT;
+    t[S_INT][C_SPACE] = S_TRAIL;
+    t[S_TRAIL][C_SPACE] = S_TRAIL;
+    accept[integer][S_INT] = accept[integer][S_TRAIL] = true;
+    if (!integer) {
+      t[S_START][C_DOT] = t[S_SIGN][C_DOT] = S_DOT;
+      t[S_INT][C_DOT] = S_FRAC;
+      t[S_DOT][C_DIGIT] = S_FRAC;
+      t[S_FRAC][C_DIGIT] = S_FRAC;
+      t[S_FRAC][C_SPACE] = S_TRAIL;
+      t[S_INT][C_EXP] = t[S_FRAC][C_EXP] = S_EXP;
+      t[S_EXP][C_SIGN] = S_EXP_SIGN;
+      t[S_EXP][C_DIGIT] = t[S_EXP_SIGN][C_DIGIT] = S_EXP_DIGITS;
+      t[S_EXP_DIGITS][C_DIGIT] = S_EXP_DIGITS;
+      t[S_EXP_DIGITS][C_SPACE] = S_TRAIL;
+      accept[integer][S_FRAC] = accept[integer][S_EXP_DIGITS] = true;
+    }
+
+    for (int state=0; state<N_STATES; ++state) {
+      for (int c=0; c<256; ++c)
+        next[integer][state][c] = t[state][classes[c]];
+    }
+  }
+}
+
+const NumberDFA& number_dfa()
+{
+  static const NumberDFA dfa;
+  return dfa;
+}
+
+inline bool run_number_dfa(const NumberDFA& dfa, const char* p, const char* end, bool integer)
+{
+  const std::uint8_t (&t)[N_STATES][256] = dfa.next[integer];
+  int state = S_START;
+  for (; p != end; ++p)
+    state = t[state][static_cast<unsigned char>(*p)];
+  return dfa.accept[integer][state];
+}
+
+// ------------------------------------------------------------------------
+
+template<typename F>
+std::size_t parse_columns_impl(std::string_view text, const char* separator_chars, bool clean,
+    F* values, std::size_t count, F undefined)
+{
+  std::size_t n = 0;
+  if (count == 0)
+    return n;
+
+  SplitViews splitter(text, 0, separator_chars, clean);
+  for (std::string_view token; splitter.next(token); ) {
+    const char* begin = token.data();
+    const char* end = begin + token.size();
+    F& v = values[n];
+    if (!parse_number(begin, end, v))
+      v = undefined;
+    if (++n == count)
+      break;
+  }
+  return n;
+}
+
+} // namespace
+
+bool parse_number(const char* begin, const char* end, double& value)
+{
+  return parse_plain_decimal(begin, end, value) || parse_floating(begin, end, value);
+}
+
+bool parse_number(const char* begin, const char* end, float& value)
+{
+  return parse_plain_decimal(begin, end, value) || parse_floating(begin, end, value);
+}
+
+bool parse_number(const char* begin, const char* end, long& value)
+{
+  return parse_integer(begin, end, value);
+}
+
+bool parse_number(const char* begin, const char* end, int& value)
+{
+  return parse_integer(begin, end, value);
+}
+
+bool parse_digits(const char* begin, const char* end, int& value)
+{
+  const std::ptrdiff_t n = end - begin;
+  if (n < 1 || n > 9)
+    return false;
+  std::uint64_t v;
+  if (n >= 8) {
+    if (!parse_8_digits(begin, v))
+      return false;
+    begin += 8;
+  } else {
+    // leading zeros do not change the value
+    char padded[8];
+    std::memset(padded, '0', 8 - n);
+    std::memcpy(padded + 8 - n, begin, n);
+    if (!parse_8_digits(padded, v))
+      return false;
+    begin = end;
+  }
+  for (; begin != end; ++begin) {
+    if (!is_digit(*begin))
+      return false;
+    v = 10*v + (*begin - '0');
+  }
+  value = static_cast<int>(v);
+  return true;
+}
+
+int scan_ints(std::string_view text, const char* format, std::initializer_list<int*> values)
+{
+  const char* p = text.data();
+  const char* const end = p + text.size();
+  std::initializer_list<int*>::const_iterator value = values.begin();
+  int n = 0;
+  while (*format) {
+    if (*format == '%') {
+      int width = 0;
+      for (++format; is_digit(*format); ++format)
+        width = 10*width + (*format - '0');
+      if (*format++ != 'd' || value == values.end())
+        break;
+
+      while (p != end && is_space(*p))
+        ++p;
+      const char* const field_end = (width > 0 && end - p > width) ? p + width : end;
+      const char* q = p;
+      const bool negative = (q != field_end && *q == '-');
+      if (q != field_end && (*q == '-' || *q == '+'))
+        ++q;
+      const char* const digits = q;
+      int v = 0;
+      for (; q != field_end && is_digit(*q); ++q)
+        v = 10*v + (*q - '0');
+      if (q == digits)
+        break;
+      **value++ = negative ? -v : v;
+      n += 1;
+      p = q;
+    } else if (is_space(*format)) {
+      ++format;
+      while (p != end && is_space(*p))
+        ++p;
+    } else {
+      if (p == end || *p != *format)
+        break;
+      ++p;
+      ++format;
+    }
+  }
+  return n;
+}
+
+bool is_number(const char* begin, const char* end)
+{
+  return run_number_dfa(number_dfa(), begin, end, false);
+}
+
+bool is_int(const char* begin, const char* end)
+{
+  return run_number_dfa(number_dfa(), begin, end, true);
+}
+
+std::size_t validate_numbers(const std::string_view* fields, std::size_t count, std::uint64_t* mask, bool integer)
+{
+  const NumberDFA& dfa = number_dfa();
+  std::fill(mask, mask + (count + 63) / 64, 0);
+  std::size_t valid = 0;
+  for (std::size_t i=0; i<count; ++i) {
+    const char* begin = fields[i].data();
+    const std::uint64_t ok = run_number_dfa(dfa, begin, begin + fields[i].size(), integer);
+    mask[i / 64] |= ok << (i % 64);
+    valid += ok;
+  }
+  return valid;
+}
+
+std::size_t validate_columns(std::string_view text, const char* separator_chars, bool clean,
+    std::uint64_t* mask, std::size_t count, bool integer)
+{
+  const NumberDFA& dfa = number_dfa();
+  std::fill(mask, mask + (count + 63) / 64, 0);
+  std::size_t n = 0;
+  if (count == 0)
+    return n;
+
+  SplitViews splitter(text, 0, separator_chars, clean);
+  for (std::string_view token; splitter.next(token); ) {
+    const std::uint64_t ok = run_number_dfa(dfa, token.data(), token.data() + token.size(), integer);
+    mask[n / 64] |= ok << (n % 64);
+    if (++n == count)
+      break;
+  }
+  return n;
+}
+
+std::size_t parse_columns(std::string_view text, const char* separator_chars, bool clean,
+    double* values, std::size_t count, double undefined)
+{
+  return parse_columns_impl(text, separator_chars, clean, values, count, undefined);
+}
+
+std::size_t parse_columns(std::string_view text, const char* separator_chars, bool clean,
+    float* values, std::size_t count, float undefined)
+{
+  return parse_columns_impl(text, separator_chars, clean, values, count, undefined);
+}
+
+} // namespace miutil
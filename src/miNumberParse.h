@@ -0,0 +1,128 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MINUMBERPARSE_H
+#define PUTOOLS_MINUMBERPARSE_H
+
+#include "miStringFunctions.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+namespace miutil {
+
+/**
+ * Parse a number in one pass, independent of the current locale.
+ *
+ * The accepted grammar is the one documented for miutil::is_number:
+ * optional leading and trailing whitespace, an optional + or -, a non
+ * empty sequence of digits with at most one decimal point (.), and an
+ * optional exponent (e or E) with optional sign and at least one digit.
+ *
+ * The integer versions accept the same grammar and return the integer
+ * part, like atoi does, i.e. "12.7e3" gives 12.
+ *
+ * \return false if the text is not a number or the value is out of
+ *         range; value is not modified then
+ */
+bool parse_number(const char* begin, const char* end, double& value);
+bool parse_number(const char* begin, const char* end, float& value);
+bool parse_number(const char* begin, const char* end, long& value);
+bool parse_number(const char* begin, const char* end, int& value);
+
+/**
+ * Parse 1 to 9 digits without sign or whitespace, e.g. a fixed-width
+ * date field. Digits are converted 8 at a time.
+ *
+ * \return false if [begin, end) contains anything else; value is not
+ *         modified then
+ */
+bool parse_digits(const char* begin, const char* end, int& value);
+
+/**
+ * Read integers from text like sscanf does for formats made of "%<n>d"
+ * conversions and literal characters, e.g. "%4d-%2d-%2d", but without
+ * copying text into a 0-terminated string. As for sscanf, whitespace
+ * before a number is skipped, the width includes the sign, and text
+ * after the last conversion is ignored.
+ *
+ * \return the number of values stored
+ */
+int scan_ints(std::string_view text, const char* format, std::initializer_list<int*> values);
+
+/**
+ * Check the number grammar (see parse_number) with a table-driven DFA.
+ * is_int accepts only an optional sign and digits, with optional
+ * leading and trailing whitespace.
+ */
+bool is_number(const char* begin, const char* end);
+bool is_int(const char* begin, const char* end);
+
+/**
+ * Check many fields at once. Bit (i % 64) of mask[i / 64] is set if
+ * fields[i] is a number (or an integer, if integer is true); mask must
+ * have room for (count + 63) / 64 words.
+ *
+ * \return the number of valid fields
+ */
+std::size_t validate_numbers(const std::string_view* fields, std::size_t count,
+    std::uint64_t* mask, bool integer=false);
+
+/**
+ * Like validate_numbers, for the fields of a delimited record as
+ * miutil::split(text, separator_chars, clean) would return them.
+ * At most count fields are checked.
+ *
+ * \return the number of fields checked
+ */
+std::size_t validate_columns(std::string_view text, const char* separator_chars, bool clean,
+    std::uint64_t* mask, std::size_t count, bool integer=false);
+
+/**
+ * Parse the fields of a delimited record directly into numbers.
+ *
+ * The fields are the tokens that miutil::split(text, separator_chars, clean)
+ * would return. Fields that are not numbers according to parse_number
+ * are stored as undefined, like to_double does. Plain decimals like
+ * "-12.25" are converted with a fast path reading 8 digits at a time.
+ *
+ * Parsing stops after count fields; values beyond the returned number
+ * are not modified.
+ *
+ * \return the number of fields stored in values
+ */
+std::size_t parse_columns(std::string_view text, const char* separator_chars, bool clean,
+    double* values, std::size_t count, double undefined=NAN);
+std::size_t parse_columns(std::string_view text, const char* separator_chars, bool clean,
+    float* values, std::size_t count, float undefined=NAN);
+
+} // namespace miutil
+
+#endif // PUTOOLS_MINUMBERPARSE_H
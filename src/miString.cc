@@ -27,8 +27,12 @@
 
 #define METLIBS_SUPPRESS_DEPRECATED
 #include "miString.h"
+#include "miCharTransform.h"
+#include "miNumberParse.h"
+#include "miStringSplit.h"
+#include "miUtf8.h"
 
-#include <boost/algorithm/string/case_conv.hpp>
+#include <charconv>
 #include <iomanip>
 
 using namespace puAlgo;
@@ -37,153 +41,217 @@ namespace miutil {
 
 std::string from_latin1_to_utf8(const std::string& latin1)
 {
-  std::string utf8;
-  utf8.reserve(latin1.size());
-  for (char ch : latin1) {
-    unsigned char uch = static_cast<unsigned char>(ch);
-    if ((uch & 0x80) != 0) {
-      unsigned char uch1 = (0xc0 | (uch >> 6)); /* first byte, simplified since our range is only 8-bits */
-      utf8 += static_cast<char>(uch1);
+  std::string utf8(utf8_size_of_latin1(latin1), '\0');
+  latin1_to_utf8(latin1, &utf8[0]);
+  return utf8;
+}
+
+std::string from_utf8_to_latin1(const std::string& utf8, const char replacement)
+{
+  std::string latin1;
+  Utf8ToLatin1Converter converter(replacement);
+  converter.convert(utf8, latin1);
+  converter.finish(latin1);
+  return latin1;
+}
 
-      uch = (0x80 | (uch & 0x3f));
+namespace {
+const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// writes the digits of u so that they end just before end, returns the first digit
+char* write_digits_backwards(char* end, unsigned int u)
+{
+    while (u >= 100) {
+        const unsigned int pair = 2 * (u % 100);
+        u /= 100;
+        end -= 2;
+        end[0] = digit_pairs[pair];
+        end[1] = digit_pairs[pair + 1];
     }
-    utf8 += static_cast<char>(uch);
-  }
-  return utf8;
+    if (u >= 10) {
+        end -= 2;
+        end[0] = digit_pairs[2*u];
+        end[1] = digit_pairs[2*u + 1];
+    } else {
+        *--end = char('0' + u);
+    }
+    return end;
 }
 
-std::string from_number(const int i, const int width, const char fill)
+// worst case size of format_number output for floating point numbers
+size_t max_float_chars(int prec)
 {
-    std::ostringstream ost;
-    if (width>0) {
-#if defined(__WIN32__) || defined(__WIN64__)
-        ost << std::setw(width) << std::setfill(static_cast<char>(fill)) << i;
-#else
-        ost << std::setw(width) << std::setfill(fill) << i;
-#endif
+    // sign, "0.000", digits, or sign, digit, '.', digits, "e-308"
+    return (prec < 0) ? 32 : (prec + 8);
+}
+
+template<typename F>
+char* format_floating(char* first, char* last, F d, int prec)
+{
+    std::to_chars_result r;
+    if (prec == PRECISION_SHORTEST)
+        r = std::to_chars(first, last, d);
+    else
+        r = std::to_chars(first, last, d, std::chars_format::general, (prec < 0) ? 6 : prec);
+    return (r.ec == std::errc()) ? r.ptr : nullptr;
+}
+
+template<typename F>
+void append_floating(std::string& text, F d, int prec)
+{
+    const size_t old = text.size();
+    text.resize(old + max_float_chars(prec));
+    char* first = &text[0];
+    char* end = format_floating(first + old, first + text.size(), d, prec);
+    text.resize(end - first);
+}
+} // namespace
+
+char* format_number(char* first, char* last, const int i, const int width, const char fill)
+{
+    // like std::setw and std::setfill, i.e. padding goes before the sign
+    char digits[16];
+    char* end = digits + sizeof(digits);
+    const unsigned int u = (i < 0) ? 0u - static_cast<unsigned int>(i) : i;
+    char* begin = write_digits_backwards(end, u);
+    if (i < 0)
+        *--begin = '-';
+
+    const ptrdiff_t ndigits = end - begin;
+    const ptrdiff_t padding = (width > ndigits) ? (width - ndigits) : 0;
+    if (last - first < ndigits + padding)
+        return nullptr;
+    first = std::fill_n(first, padding, fill);
+    return std::copy(begin, end, first);
+}
+
+char* format_number(char* first, char* last, const double d, const int prec)
+{
+    return format_floating(first, last, d, prec);
+}
+
+char* format_number(char* first, char* last, const float d, const int prec)
+{
+    return format_floating(first, last, d, prec);
+}
+
+void append_number(std::string& text, const int i, const int width, const char fill)
+{
+    char buffer[16];
+    if (width < int(sizeof(buffer))) {
+        char* end = format_number(buffer, buffer + sizeof(buffer), i, width, fill);
+        text.append(buffer, end);
     } else {
-        ost << i;
+        const size_t old = text.size();
+        text.resize(old + width);
+        format_number(&text[old], &text[0] + text.size(), i, width, fill);
     }
-    return ost.str();
+}
+
+void append_number(std::string& text, const double d, const int prec)
+{
+    append_floating(text, d, prec);
+}
+
+void append_number(std::string& text, const float d, const int prec)
+{
+    append_floating(text, d, prec);
+}
+
+std::string from_number(const int i, const int width, const char fill)
+{
+    std::string text;
+    append_number(text, i, width, fill);
+    return text;
 }
 
 std::string from_number(const double d, const int prec)
 {
-    std::ostringstream ost;
-    if (prec!=-1)
-        ost.precision(prec);
-    ost << d;
-    return ost.str();
+    char buffer[32];
+    if (char* end = format_number(buffer, buffer + sizeof(buffer), d, prec))
+        return std::string(buffer, end);
+    std::string text;
+    append_number(text, d, prec);
+    return text;
 }
 
 std::string from_number(const float d, const int prec)
 {
-    std::ostringstream ost;
-    if (prec!=-1)
-        ost.precision(prec);
-    ost << d;
-    return ost.str();
+    char buffer[32];
+    if (char* end = format_number(buffer, buffer + sizeof(buffer), d, prec))
+        return std::string(buffer, end);
+    std::string text;
+    append_number(text, d, prec);
+    return text;
 }
 
 namespace {
 bool trim_limits(const std::string& text, bool left, bool right, const char* wspace, size_t& begin, size_t& end)
 {
+  const CharSet& ws = (wspace == whitespaces) ? CharSet::whitespace() : CharSet(wspace);
   const size_t len = text.length();
   begin = 0;
   end = len;
   if (left) {
-    begin = text.find_first_not_of(wspace);
+    begin = ws.find_first_not_in(text);
     if (begin == std::string::npos)
       begin = len;
   }
   if (right) {
-    const size_t e = text.find_last_not_of(wspace);
+    const size_t e = ws.find_last_not_in(text);
     if (e != std::string::npos)
       end = e + 1;
   }
   return begin != 0 || end != len;
 }
+} // namespace
 
-bool trim_will_change(const std::string& text, bool left, bool right, const char* wspace)
+void trim(std::string& text, bool left, bool right, const char* wspace)
 {
   size_t begin, end;
-  return trim_limits(text, left, right, wspace, begin, end);
-}
-
-std::string do_trim(const std::string& text, size_t begin, size_t end)
-{
-  return std::string(text.begin() + begin, text.begin() + end);
+  if (trim_limits(text, left, right, wspace, begin, end)) {
+    text.erase(end);
+    text.erase(0, begin);
+  }
 }
 
-bool trim_changed(std::string& text, bool left, bool right, const char* wspace)
+std::string trimmed(const std::string& text, bool left, bool right, const char* wspace)
 {
   size_t begin, end;
-  if (!trim_limits(text, left, right, wspace, begin, end))
-    return false;
-
-  text = do_trim(text, begin, end);
-  return true;
-}
-} // namespace
-
-void trim(std::string& text, bool left, bool right, const char* wspace)
-{
-  trim_changed(text, left, right, wspace);
+  trim_limits(text, left, right, wspace, begin, end);
+  return text.substr(begin, end - begin);
 }
 
 void trim_remove_empty(std::vector<std::string>& vec)
 {
-  const bool left = true, right = true;
-  const char* wspace = whitespaces;
-
-  const auto first_changed = std::find_if(vec.begin(), vec.end(), [=](const std::string& s) { return s.empty() || trim_will_change(s, left, right, wspace); });
-  if (first_changed == vec.end())
-    return;
-
-  std::vector<std::string> cleaned(vec.begin(), first_changed);
-  cleaned.reserve(vec.size());
-  for (auto it = first_changed; it != vec.end(); ++it) {
+  auto out = vec.begin();
+  for (auto it = vec.begin(); it != vec.end(); ++it) {
+    trim(*it);
     if (it->empty())
       continue;
-    size_t begin, end;
-    if (trim_limits(*it, left, right, wspace, begin, end)) {
-      if (begin != end)
-        cleaned.push_back(do_trim(*it, begin, end));
-    } else {
-      cleaned.push_back(*it);
-    }
+    if (out != it)
+      *out = std::move(*it);
+    ++out;
   }
-  vec = std::move(cleaned);
+  vec.erase(out, vec.end());
 }
 
 std::vector<std::string> split(const std::string& text, int nos, const char* separator_chars, const bool clean)
 {
     std::vector<std::string> vec;
-    if (text.empty())
-        return vec;
-
-    int splitnumber = 0;
-    size_t len = text.length();
-    size_t start=(clean? text.find_first_not_of(separator_chars, 0): 0);
-    while (start != std::string::npos && start<len) {
-        size_t stop = text.find_first_of(separator_chars, start);
-        if (stop == std::string::npos || stop > len)
-            stop=len;
-        vec.push_back(text.substr(start, stop-start));
-        
-        if(nos)
-            if(++splitnumber >= nos) {
-                stop++;
-                if(stop < len )
-                    vec.push_back(text.substr(stop,len-stop));
-                break;
-            }
-        start=(clean? text.find_first_not_of(separator_chars, stop+1): stop+1);
-    }
-    
-    if (clean)
-        trim_remove_empty(vec);
-
+    SplitViews splitter(text, nos, separator_chars, clean);
+    for (std::string_view token; splitter.next(token); )
+        vec.emplace_back(token);
     return vec;
 }
 
@@ -194,58 +262,25 @@ std::vector<std::string> split_protected(const std::string& text,
                                          const bool clean)
 {
     std::vector<std::string> vec;
-    if (text.empty())
-        return vec;
-
-    const size_t len = text.length();
-    size_t start = (clean ? text.find_first_not_of(separator_chars, 0): 0);
-
-    while (start != std::string::npos && start<len) {
-        size_t stop = text.find_first_of(separator_chars, start);
-        size_t tmp = start;
-        bool isok = false;
-        while (not isok) {
-            const size_t lbp = text.find(lb, tmp);
-            if (lbp != std::string::npos && lbp < stop) {
-                const size_t rbp = text.find(rb, lbp+1);
-                if (rbp == std::string::npos)
-                    return vec;
-                tmp = rbp+1;
-                if (rbp != std::string::npos && rbp > stop)
-                    stop = text.find_first_of(separator_chars, tmp);
-            } else {
-                isok = true;
-            }
-        }
-        if (stop == std::string::npos || stop>len)
-            stop=len;
-
-        vec.push_back(text.substr(start, stop-start));
-        start = (clean ? text.find_first_not_of(separator_chars, stop+1): stop+1);
-    }
-    
-    if (clean)
-        trim_remove_empty(vec);
-
+    ProtectedSplitViews splitter(text, lb, rb, separator_chars, clean);
+    for (std::string_view token; splitter.next(token); )
+        vec.emplace_back(token);
     return vec;
 }
 
 void remove(std::string& text, const char c)
 {
-    if (text.empty())
-        return;
-
-    for (size_t pos=text.find(c); pos!=std::string::npos; pos=text.find(c))
-        text.erase(pos,1);
+    CharSet chars;
+    chars.add(c);
+    remove_chars(text, chars);
 }
 
 
 void replace(std::string& text, const char thys, const char that)
 {
-    const size_t len = text.size();
-    for (size_t i=0; i<len; i++)
-        if (text[i]==thys)
-            text[i]=that;
+    CharSet chars;
+    chars.add(thys);
+    replace_chars(text, chars, that);
 }
 
 void replace(std::string& text, const std::string& thys, const std::string& that)
@@ -260,205 +295,206 @@ void replace(std::string& text, const std::string& thys, const std::string& that
     }
 }
 
-bool is_number(const std::string& text)
+bool is_number(std::string_view text)
 {
-    if (text.empty())
-        return false;
-    
-    bool fl=false;
-    std::string::const_iterator i1, i2;
-    
-    for (i1=text.begin(); i1!=text.end() && isspace(*i1); i1++);
-    
-    if(i1==text.end())
-        return false;
-    
-    for (i2=text.end()-1; isspace(*i2); i2--);
-    
-    if(i2!=text.end())
-        i2++;
-    
-    if(*i1=='-' || *i1=='+'){
-        i1++;
-        
-        if(*i1=='e' || *i1=='E')
-            return false;
-        // only a - or + is not accepted
-        if(i1==i2)
-            return false;
-    }
-    
-    if(*i1=='e' || *i1=='E')
-        return false;
-    
-    for (; i1!=i2; i1++) {
-        if (!isdigit(*i1)) {
-            if (*i1=='.') {
-                if (fl)
-                    return false;
-                else
-                    fl=true;
-            } else
-                break;
-        }
-    }
-    
-    if(*i1=='e' || *i1=='E'){
-        i1++;
-        
-        // we dont accept a number ending in e or E.
-        if(i1==i2)
-            return false;
-    }
-    
-    if(*i1=='-' || *i1=='+'){
-        i1++;
-        
-        if(i1==i2)
-            return false;
-    }
-    
-    for (; i1!=i2; i1++)
-        if (!isdigit(*i1))
-            return false;
-    
-    return true;
+    const char* begin = text.data();
+    return is_number(begin, begin + text.size());
 }
 
-bool is_int(const std::string& text)
+bool is_int(std::string_view text)
 {
-    if (text.empty())
-        return false;
-    
-    std::string::const_iterator i1, i2;
-    
-    for (i1=text.begin(); i1!=text.end() && isspace(*i1); i1++);
-    
-    if(i1==text.end())
-        return false;
-    
-    for (i2=text.end()-1; isspace(*i2); i2--);
-    
-    if(i2!=text.end())
-        i2++;
-    
-    if(*i1=='-' || *i1=='+'){
-        i1++;
-        
-        // only a - or + is not accepted
-        if(i1==i2)
-            return false;
-    }
-    
-    for (; i1!=i2; i1++){
-        if (!isdigit(*i1)){
-            return false;
-        }
-    }
-    
-    return true;
+    const char* begin = text.data();
+    return is_int(begin, begin + text.size());
+}
+
+int to_int(std::string_view text, const int undefined)
+{
+    return to_int(text.data(), text.size(), undefined);
+}
+
+long to_long(std::string_view text, const long undefined)
+{
+    return to_long(text.data(), text.size(), undefined);
 }
 
-int to_int(const std::string& text, const int undefined)
+float to_float(std::string_view text, const float undefined)
 {
-    if (text.empty() or not is_number(text))
-        return undefined;
-    return std::atoi(text.c_str());
+    return to_float(text.data(), text.size(), undefined);
 }
 
-long to_long(const std::string& text, const long undefined)
+double to_double(std::string_view text, const double undefined)
 {
-    if (text.empty() or not is_number(text))
-        return undefined;
-    return std::atol(text.c_str());
+    return to_double(text.data(), text.size(), undefined);
 }
 
-float to_float(const std::string& text, const float undefined)
+int to_int(const char* text, size_t length, const int undefined)
 {
-#if 1
-    float ret = undefined;
-    char test = 0;
-    std::istringstream iss(text);
-    iss.imbue(std::locale::classic());
-    iss >> ret >> test;
-    if (not iss.eof())
-      return undefined;
-    return ret;
-#else
-    if (text.empty() or not is_number(text))
-        return undefined;
-    return std::atof(text.c_str());
-#endif
+    int value;
+    return parse_number(text, text + length, value) ? value : undefined;
 }
 
-double to_double(const std::string& text, const double undefined)
+long to_long(const char* text, size_t length, const long undefined)
 {
-#if 1
-    double ret = undefined;
-    char test = 0;
-    std::istringstream iss(text);
-    iss.imbue(std::locale::classic());
-    iss >> ret >> test;
-    if (not iss.eof())
-      return undefined;
-    return ret;
-#else
-    if (text.empty() or not is_number(text))
-        return undefined;
-    return std::atof(text.c_str());
-#endif
+    long value;
+    return parse_number(text, text + length, value) ? value : undefined;
+}
+
+float to_float(const char* text, size_t length, const float undefined)
+{
+    float value;
+    return parse_number(text, text + length, value) ? value : undefined;
+}
+
+double to_double(const char* text, size_t length, const double undefined)
+{
+    double value;
+    return parse_number(text, text + length, value) ? value : undefined;
 }
 
 std::string to_lower(const std::string& text)
 {
-  return boost::algorithm::to_lower_copy(text, std::locale::classic());
+  std::string t(text);
+  to_lower_inplace(t);
+  return t;
+}
+
+std::string to_lower(std::string&& text)
+{
+  to_lower_inplace(text);
+  return std::move(text);
+}
+
+void to_lower_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_lower_inplace(first, first + text.size());
 }
 
 std::string to_lower_latin1(const std::string& text)
 {
   std::string t(text);
-  for (size_t i=0; i<t.size(); ++i) {
-    unsigned char c = tolower(t[i]);
-    if ((c>=192 && c<=214) || (c>=216 && c<=222))
-      c+=32;
-    t[i] = c;
-  }
+  to_lower_latin1_inplace(t);
   return t;
 }
 
+std::string to_lower_latin1(std::string&& text)
+{
+  to_lower_latin1_inplace(text);
+  return std::move(text);
+}
+
+void to_lower_latin1_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_lower_latin1_inplace(first, first + text.size());
+}
+
 std::string to_upper(const std::string& text)
 {
-  return boost::algorithm::to_upper_copy(text, std::locale::classic());
+  std::string t(text);
+  to_upper_inplace(t);
+  return t;
+}
+
+std::string to_upper(std::string&& text)
+{
+  to_upper_inplace(text);
+  return std::move(text);
+}
+
+void to_upper_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_upper_inplace(first, first + text.size());
 }
 
 std::string to_upper_latin1(const std::string& text)
 {
   std::string t(text);
-  for (size_t i=0; i<t.size(); ++i) {
-    unsigned char c = toupper(t[i]);
-    if ((c>=224 && c<=246) || (c>=248 && c<=254))
-      c-=32;
-    t[i] = c;
-  }
+  to_upper_latin1_inplace(t);
+  return t;
+}
+
+std::string to_upper_latin1(std::string&& text)
+{
+  to_upper_latin1_inplace(text);
+  return std::move(text);
+}
+
+void to_upper_latin1_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_upper_latin1_inplace(first, first + text.size());
+}
+
+std::string to_lower_utf8(const std::string& text)
+{
+  std::string t(text);
+  to_lower_utf8_inplace(t);
+  return t;
+}
+
+std::string to_lower_utf8(std::string&& text)
+{
+  to_lower_utf8_inplace(text);
+  return std::move(text);
+}
+
+void to_lower_utf8_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_lower_utf8_inplace(first, first + text.size());
+}
+
+std::string to_upper_utf8(const std::string& text)
+{
+  std::string t(text);
+  to_upper_utf8_inplace(t);
   return t;
 }
 
-std::string append(const std::string& a, const std::string& separator, const std::string& b)
+std::string to_upper_utf8(std::string&& text)
+{
+  to_upper_utf8_inplace(text);
+  return std::move(text);
+}
+
+void to_upper_utf8_inplace(std::string& text)
+{
+  char* first = &text[0];
+  to_upper_utf8_inplace(first, first + text.size());
+}
+
+std::string appended(const std::string& a, const std::string& separator, const std::string& b)
 {
   if (b.empty())
     return a;
   if (a.empty())
     return b;
-  return a + separator + b;
+  std::string t;
+  t.reserve(a.size() + separator.size() + b.size());
+  t += a;
+  t += separator;
+  t += b;
+  return t;
+}
+
+std::string appended(std::string&& a, const std::string& separator, const std::string& b)
+{
+  appendTo(a, separator, b);
+  return std::move(a);
 }
 
 void appendTo(std::string& a, const std::string& separator, const std::string& b)
 {
   if (not b.empty()) {
-    if (a.empty())
+    if (a.empty()) {
       a = b;
-    else
-      a += separator + b;
+    } else {
+      a.reserve(a.size() + separator.size() + b.size());
+      a += separator;
+      a += b;
+    }
   }
 }
 
@@ -489,40 +525,24 @@ miString::miString(const float f, const int prec)
 int
 miString::toInt( const int undefined ) const
 {
-  if(empty())
-    return undefined;
-  if(!isNumber())
-    return undefined;
-  return atoi(c_str());
+  return miutil::to_int(*this, undefined);
 }
 
 long
 miString::toLong( const long undefined ) const
 {
-  if(empty())
-    return undefined;
-  if(!isNumber())
-    return undefined;
-  return atol(c_str());
+  return miutil::to_long(*this, undefined);
 }
 
 float
 miString::toFloat( const float undefined ) const
 {
-  if(empty())
-    return undefined;
-  if(!isNumber())
-    return undefined;
-  return atof(c_str());
+  return miutil::to_float(*this, undefined);
 }
 
 double miString::toDouble( const double undefined ) const
 {
-  if(empty())
-    return undefined;
-  if(!isNumber())
-    return undefined;
-  return atof(c_str());
+  return miutil::to_double(*this, undefined);
 }
 
 void
@@ -592,49 +612,9 @@ miString::split(const char lb, // left border
     const bool clean) const
 {
   std::vector<miString> vec;
-  if (!empty()) {
-
-    size_t len=length();
-
-    size_t start=(clean ? find_first_not_of(s,0): 0);
-
-    while (start != std::string::npos && start<len) {
-      size_t stop;
-
-      stop=find_first_of(s,start);
-
-      size_t  tmp= start;
-      bool isok=false;
-      while ( !isok ){
-        size_t lbp = find(lb,tmp);
-        if (lbp != std::string::npos && lbp < stop) {
-          size_t rbp = find(rb,lbp+1);
-          if ( rbp == npos ) {
-            return vec;
-          }
-          tmp=rbp+1;
-          if (rbp != std::string::npos && rbp > stop) {
-            stop = find_first_of(s,tmp);
-          }
-        } else isok=true;
-      }
-
-      if (stop == std::string::npos || stop>len)
-        stop=len;
-
-      vec.push_back(substr(start,stop-start));
-
-      start=(clean? find_first_not_of(s,stop+1): stop+1);
-    }
-
-
-    if (clean)
-      for (size_t i=0; i<vec.size(); i++) {
-        vec[i].trim();
-        if (!(vec[i].exists()))
-          vec.erase(vec.begin()+i--);
-      }
-  }
+  miutil::ProtectedSplitViews splitter(*this, lb, rb, s.c_str(), clean);
+  for (std::string_view token; splitter.next(token); )
+    vec.push_back(miString(std::string(token)));
   return vec;
 }
 
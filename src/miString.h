@@ -29,12 +29,35 @@
 #define __dnmi_miString__
 
 #include "miStringFunctions.h"
+#include "miStringJoin.h"
 #include "puCtools/deprecated.h"
 #include <sstream>
 #include "puAlgo.h"
 
 namespace miutil {
 
+namespace detail {
+// join strings and numbers without iostreams, characters and other types with an ostringstream
+template<class C>
+std::string join_any(const C& j, const std::string& delimiter)
+{
+    typedef typename C::value_type T;
+    if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+        return miutil::join(j, delimiter);
+    } else if constexpr (std::is_arithmetic<T>::value && sizeof(T) > 1) {
+        return miutil::join_numbers(j, delimiter);
+    } else {
+        bool first=true;
+        std::ostringstream ost;
+        for (const T& t : j) {
+            ost << (first ? "" : delimiter ) << t;
+            first = false;
+        }
+        return ost.str();
+    }
+}
+} // namespace detail
+
 class miString : public std::string
 {
 public:
@@ -43,6 +66,8 @@ public:
   METLIBS_DEPRECATED(miString(const char* s), "use 'miutil::from_c_str(s)' if 0-protection is required");
   miString(const std::string& s)
     : std::string(s) {}
+  miString(std::string&& s)
+    : std::string(std::move(s)) {}
 
   METLIBS_DEPRECATED(METLIBS_CONCAT(explicit miString(const int    d, const int width=0, const char fill='0')), "use 'from_number(...)'");
   METLIBS_DEPRECATED(METLIBS_CONCAT(explicit miString(const double d, const int prec =-1)), "use 'from_number(...)'");
@@ -86,10 +111,10 @@ public:
 
 
   METLIBS_DEPRECATED(METLIBS_CONCAT(template< template< typename T, typename ALLOC = std::allocator<T> > class C, typename T>
-                    inline void join(const C<T>& j, const miString delimiter=" ")), "use 'boost::algorithm::join(j, delimiter)'");
+                    inline void join(const C<T>& j, const miString delimiter=" ")), "use 'miutil::join(j, delimiter)'");
 
   METLIBS_DEPRECATED(METLIBS_CONCAT(template< template< typename T, typename  COMPARE = std::less<T>, typename ALLOC = std::allocator<T> > class C, typename T>
-                    inline void join(const C<T>& j, const miString delimiter=" ")), "use 'boost::algorithm::join(j, delimiter)'");
+                    inline void join(const C<T>& j, const miString delimiter=" ")), "use 'miutil::join(j, delimiter)'");
 
   METLIBS_DEPRECATED(METLIBS_CONCAT(miString upcase(  int start=0, int len=0) const), "use miutil::to_upper or a charset-aware upcase function");
   METLIBS_DEPRECATED(METLIBS_CONCAT(miString downcase(int start=0, int len=0) const), "use miutil::to_lower or a charset-aware downcase function");
@@ -107,27 +132,13 @@ public:
 template< template< typename T, typename ALLOC = std::allocator<T> > class C, typename T>
 inline void miString::join(const C<T>& j, const miString delimiter)
 {
-    bool first=true;
-    std::ostringstream ost;
-    typename C<T>::const_iterator itr= j.begin();
-    for(;itr!=j.end();itr++){
-      ost << (first ? "" : delimiter ) << *itr;
-      first = false;
-    }
-    *this=ost.str();
+    *this = detail::join_any(j, delimiter);
 }
 
 template< template< typename T, typename  COMPARE = std::less<T>, typename ALLOC = std::allocator<T> > class C, typename T>
 inline void miString::join(const C<T>& j, const miString delimiter)
 {
-    bool first=true;
-    std::ostringstream ost;
-    typename C<T>::const_iterator itr= j.begin();
-    for(;itr!=j.end();itr++){
-      ost << (first ? "" : delimiter ) << *itr;
-      first = false;
-    }
-    *this=ost.str();
+    *this = detail::join_any(j, delimiter);
 }
 
 } // namespace miutil
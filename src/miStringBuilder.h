@@ -28,8 +28,14 @@
 #ifndef PUTOOLS_MISTRINGBUILDER_H
 #define PUTOOLS_MISTRINGBUILDER_H
 
-#include <string>
+#include "miStringFunctions.h"
+
+#include <charconv>
+#include <iomanip>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace miutil {
 
@@ -51,6 +57,116 @@ private:
     std::ostringstream s;
 };
 
+/*! Build a string with stream-like syntax in a reusable buffer.
+ *
+ * Like StringBuilder, but text is appended to a contiguous buffer;
+ * strings, characters, integers and floating point numbers are
+ * formatted without going through iostreams (numbers look like they
+ * would with a default std::ostream). Other types are formatted with a
+ * temporary std::ostringstream. There is no stream state, so stream
+ * manipulators like std::setw or std::hex do not compile.
+ *
+ * clear() keeps the capacity, so a buffer may be reused for many
+ * strings without allocating again.
+ */
+class StringBuffer {
+public:
+    StringBuffer() { }
+
+    explicit StringBuffer(size_t capacity)
+        { s.reserve(capacity); }
+
+    template<typename T>
+    StringBuffer& operator<<(const T& t) &
+        { append(t); return *this; }
+
+    template<typename T>
+    StringBuffer&& operator<<(const T& t) &&
+        { append(t); return std::move(*this); }
+
+    StringBuffer& reserve(size_t capacity)
+        { s.reserve(capacity); return *this; }
+
+    //! remove the text, but keep the capacity
+    void clear()
+        { s.clear(); }
+
+    bool empty() const
+        { return s.empty(); }
+
+    size_t size() const
+        { return s.size(); }
+
+    std::string_view view() const
+        { return s; }
+
+    const std::string& str() const &
+        { return s; }
+
+    //! move the text out of the buffer
+    std::string str() &&
+        { return std::move(s); }
+
+    operator std::string() const &
+        { return s; }
+
+    operator std::string() &&
+        { return std::move(s); }
+
+private:
+    template<typename T>
+    void append(const T& t);
+
+    template<typename I>
+    void append_integer(I t)
+        { char buf[24]; s.append(buf, std::to_chars(buf, buf + sizeof(buf), t).ptr); }
+
+private:
+    std::string s;
+};
+
+namespace detail {
+template<typename T>
+struct is_stream_manipulator
+    : std::integral_constant<bool, std::is_function<T>::value
+        || std::is_same<T, decltype(std::setw(0))>::value
+        || std::is_same<T, decltype(std::setfill('0'))>::value
+        || std::is_same<T, decltype(std::setprecision(0))>::value
+        || std::is_same<T, decltype(std::setbase(0))>::value
+        || std::is_same<T, decltype(std::setiosflags(std::ios_base::fmtflags()))>::value
+        || std::is_same<T, decltype(std::resetiosflags(std::ios_base::fmtflags()))>::value>
+{ };
+} // namespace detail
+
+template<typename T>
+void StringBuffer::append(const T& t)
+{
+    static_assert(!detail::is_stream_manipulator<T>::value,
+        "StringBuffer has no stream state, use StringBuilder for stream manipulators");
+
+    if constexpr (std::is_same<T, const char*>::value || std::is_same<T, char*>::value) {
+        if (t)
+            s += t;
+    } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+        s += std::string_view(t);
+    } else if constexpr (std::is_same<T, bool>::value) {
+        s += (t ? '1' : '0');
+    } else if constexpr (std::is_integral<T>::value) {
+        if constexpr (sizeof(T) == 1)
+            s += static_cast<char>(t); // char, signed char, unsigned char are written as characters
+        else if constexpr (std::is_signed<T>::value)
+            append_integer(static_cast<long long>(t));
+        else
+            append_integer(static_cast<unsigned long long>(t));
+    } else if constexpr (std::is_same<T, double>::value || std::is_same<T, float>::value) {
+        append_number(s, t);
+    } else {
+        std::ostringstream ost;
+        ost << t;
+        s += ost.str();
+    }
+}
+
 } // namespace miutil
 
 #endif // PUTOOLS_MISTRINGBUILDER_H
@@ -0,0 +1,226 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "miStringCompare.h"
+
+#include "miCharSet.h"
+#include "miCharTransform.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define PUTOOLS_STRINGCOMPARE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace miutil {
+
+namespace {
+
+enum Fold { FOLD_ASCII, FOLD_LATIN1 };
+
+CharMap make_fold_map(Fold fold)
+{
+  CharMap map;
+  for (int i=0; i<26; ++i)
+    map.set('A' + i, 'a' + i);
+  if (fold == FOLD_LATIN1) {
+    // 0xC0-0xDE -> 0xE0-0xFE, except the multiplication sign
+    for (int i=0xC0; i<=0xDE; ++i) {
+      if (i != 0xD7)
+        map.set(i, i + 0x20);
+    }
+  }
+  return map;
+}
+
+const CharMap& fold_map(Fold fold)
+{
+  static const CharMap maps[2] = { make_fold_map(FOLD_ASCII), make_fold_map(FOLD_LATIN1) };
+  return maps[fold];
+}
+
+inline bool use_simd()
+{
+#ifdef PUTOOLS_STRINGCOMPARE_X86
+  return CharSet::engine() != CharSet::ENGINE_SCALAR;
+#else
+  return false;
+#endif
+}
+
+#ifdef PUTOOLS_STRINGCOMPARE_X86
+// true for the bytes in [first, first+count), as in flip_case_sse2
+inline __m128i in_range_sse2(__m128i v, unsigned char first, int count)
+{
+  const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+  return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + count)));
+}
+
+// set the case bit of the uppercase letters, like fold_map
+inline __m128i fold_sse2(__m128i v, Fold fold)
+{
+  __m128i upper = in_range_sse2(v, 'A', 26);
+  if (fold == FOLD_LATIN1) {
+    const __m128i times = _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(0xD7)));
+    upper = _mm_or_si128(upper, _mm_andnot_si128(times, in_range_sse2(v, 0xC0, 31)));
+  }
+  return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif // PUTOOLS_STRINGCOMPARE_X86
+
+/// position of the first byte where a and b differ after folding, or n
+std::size_t first_difference(const char* a, const char* b, std::size_t n, Fold fold)
+{
+  std::size_t i = 0;
+#ifdef PUTOOLS_STRINGCOMPARE_X86
+  if (use_simd()) {
+    for (; i + 16 <= n; i += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+      const int equal = _mm_movemask_epi8(_mm_cmpeq_epi8(fold_sse2(va, fold), fold_sse2(vb, fold)));
+      if (equal != 0xFFFF)
+        return i + __builtin_ctz(~equal);
+    }
+  }
+#endif // PUTOOLS_STRINGCOMPARE_X86
+  const CharMap& map = fold_map(fold);
+  for (; i<n; ++i) {
+    if (map(a[i]) != map(b[i]))
+      break;
+  }
+  return i;
+}
+
+bool equals(std::string_view a, std::string_view b, Fold fold)
+{
+  return a.size() == b.size() && first_difference(a.data(), b.data(), a.size(), fold) == a.size();
+}
+
+int compare(std::string_view a, std::string_view b, Fold fold)
+{
+  const std::size_t n = std::min(a.size(), b.size());
+  const std::size_t d = first_difference(a.data(), b.data(), n, fold);
+  if (d < n) {
+    const CharMap& map = fold_map(fold);
+    return (static_cast<unsigned char>(map(a[d])) < static_cast<unsigned char>(map(b[d]))) ? -1 : 1;
+  }
+  return (a.size() < b.size()) ? -1 : ((a.size() > b.size()) ? 1 : 0);
+}
+
+bool starts_with(std::string_view text, std::string_view prefix, Fold fold)
+{
+  return prefix.size() <= text.size()
+      && first_difference(text.data(), prefix.data(), prefix.size(), fold) == prefix.size();
+}
+
+inline std::uint64_t hash_word(std::uint64_t h, std::uint64_t word)
+{
+  h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+  return h ^ (h >> 29);
+}
+
+/*
+ * Hash of the folded text, mixing 8 bytes at a time. The SSE2 and the
+ * scalar loop mix the same words in the same order, so that the hash
+ * does not depend on the engine.
+ */
+std::size_t hash(std::string_view text, Fold fold)
+{
+  const char* p = text.data();
+  std::size_t n = text.size();
+  std::uint64_t h = hash_word(0xCBF29CE484222325ull, n);
+  std::uint64_t words[2];
+#ifdef PUTOOLS_STRINGCOMPARE_X86
+  if (use_simd()) {
+    for (; n >= 16; p += 16, n -= 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(words), fold_sse2(v, fold));
+      h = hash_word(hash_word(h, words[0]), words[1]);
+    }
+  }
+#endif // PUTOOLS_STRINGCOMPARE_X86
+  const CharMap& map = fold_map(fold);
+  while (n > 0) {
+    const std::size_t count = std::min<std::size_t>(n, 8);
+    char folded[8] = { 0 };
+    for (std::size_t i=0; i<count; ++i)
+      folded[i] = map(p[i]);
+    std::memcpy(words, folded, 8);
+    h = hash_word(h, words[0]);
+    p += count;
+    n -= count;
+  }
+  return static_cast<std::size_t>(h);
+}
+
+} // namespace
+
+bool iequals(std::string_view a, std::string_view b)
+{
+  return equals(a, b, FOLD_ASCII);
+}
+
+bool iequals_latin1(std::string_view a, std::string_view b)
+{
+  return equals(a, b, FOLD_LATIN1);
+}
+
+int icompare(std::string_view a, std::string_view b)
+{
+  return compare(a, b, FOLD_ASCII);
+}
+
+int icompare_latin1(std::string_view a, std::string_view b)
+{
+  return compare(a, b, FOLD_LATIN1);
+}
+
+bool istarts_with(std::string_view text, std::string_view prefix)
+{
+  return starts_with(text, prefix, FOLD_ASCII);
+}
+
+bool istarts_with_latin1(std::string_view text, std::string_view prefix)
+{
+  return starts_with(text, prefix, FOLD_LATIN1);
+}
+
+std::size_t ihash(std::string_view text)
+{
+  return hash(text, FOLD_ASCII);
+}
+
+std::size_t ihash_latin1(std::string_view text)
+{
+  return hash(text, FOLD_LATIN1);
+}
+
+} // namespace miutil
@@ -0,0 +1,91 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PUTOOLS_MISTRINGCOMPARE_H
+#define PUTOOLS_MISTRINGCOMPARE_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace miutil {
+
+/*
+ * Case-insensitive comparison and hashing without temporary strings.
+ *
+ * The plain functions ignore the case of ASCII letters, the _latin1
+ * functions also of the ISO 8859-1 letters. Other bytes must be equal.
+ * Long texts are compared in blocks of 16 bytes with SSE2 if the CPU
+ * supports it and CharSet::engine() is not ENGINE_SCALAR; the results,
+ * including hash values, do not depend on the engine.
+ */
+
+bool iequals(std::string_view a, std::string_view b);
+bool iequals_latin1(std::string_view a, std::string_view b);
+
+/// negative, zero or positive like std::string::compare for the lowercase texts
+int icompare(std::string_view a, std::string_view b);
+int icompare_latin1(std::string_view a, std::string_view b);
+
+bool istarts_with(std::string_view text, std::string_view prefix);
+bool istarts_with_latin1(std::string_view text, std::string_view prefix);
+
+/// hash value that is equal for texts that are iequals
+std::size_t ihash(std::string_view text);
+std::size_t ihash_latin1(std::string_view text);
+
+/**
+ * Comparator for case-insensitive std::map and std::set. It is
+ * transparent, so that find() etc. accept std::string_view and
+ * const char* without constructing a std::string key.
+ */
+struct iless {
+  typedef void is_transparent;
+  bool operator()(std::string_view a, std::string_view b) const
+    { return icompare(a, b) < 0; }
+};
+
+/**
+ * Hash and equality for case-insensitive std::unordered_map and
+ * std::unordered_set. Lookup without a temporary key also needs the
+ * heterogeneous unordered lookup of C++20.
+ */
+struct ihasher {
+  typedef void is_transparent;
+  std::size_t operator()(std::string_view text) const
+    { return ihash(text); }
+};
+
+struct iequal_to {
+  typedef void is_transparent;
+  bool operator()(std::string_view a, std::string_view b) const
+    { return iequals(a, b); }
+};
+
+} // namespace miutil
+
+#endif // PUTOOLS_MISTRINGCOMPARE_H
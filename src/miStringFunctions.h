@@ -32,6 +32,8 @@
 #include <climits> 
 #include <cmath>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace miutil {
@@ -45,14 +47,37 @@ inline std::string from_c_str(const char* s)
 { return s ? std::string(s) : std::string(); }
 
 std::string from_latin1_to_utf8(const std::string& latin1);
+/** Converts UTF-8 to latin1; invalid bytes and characters outside latin1 are replaced. */
+std::string from_utf8_to_latin1(const std::string& utf8, const char replacement='?');
+
+/// precision for from_number, append_number and format_number: shortest text that reads back to the same value
+const int PRECISION_SHORTEST = -2;
 
 std::string from_number(const int d, const int width=0, const char fill='0');
 std::string from_number(const double d, const int prec =-1);
 std::string from_number(const float d, const int prec =-1);
 
+/// like from_number, but appending to text
+void append_number(std::string& text, const int d, const int width=0, const char fill='0');
+void append_number(std::string& text, const double d, const int prec =-1);
+void append_number(std::string& text, const float d, const int prec =-1);
+
+/**
+ * Like from_number, but writing to the buffer [first, last).
+ * \return the end of the written text, or nullptr if the buffer is too small
+ */
+char* format_number(char* first, char* last, const int d, const int width=0, const char fill='0');
+char* format_number(char* first, char* last, const double d, const int prec =-1);
+char* format_number(char* first, char* last, const float d, const int prec =-1);
+
+/** Removes leading and/or trailing characters from wspace, in place without reallocating. */
 void trim(std::string& text, bool left=true, bool right=true, const char* wspace=whitespaces);
-inline std::string trimmed(const std::string& text, bool left=true, bool right=true, const char* wspace=whitespaces)
-{ std::string t(text); trim(t, left, right, wspace); return t; }
+/** Copies only the trimmed part of text. */
+std::string trimmed(const std::string& text, bool left=true, bool right=true, const char* wspace=whitespaces);
+/** Trims text in place and returns it, reusing its buffer. */
+inline std::string trimmed(std::string&& text, bool left=true, bool right=true, const char* wspace=whitespaces)
+{ trim(text, left, right, wspace); return std::move(text); }
+/** Trims all strings and removes empty ones, in place. */
 void trim_remove_empty(std::vector<std::string>& strings);
 
 std::vector<std::string> split(const std::string& text, int nos, const char* separator_chars=whitespaces, const bool clean=true);
@@ -67,25 +92,51 @@ void remove(std::string& text, const char c);
 void replace(std::string& text, const char thys, const char that);
 void replace(std::string& text, const std::string& thys, const std::string& that);
 
-inline bool contains(const std::string& haystack, const std::string& needle)
+inline bool contains(std::string_view haystack, std::string_view needle)
 { return haystack.find(needle) != std::string::npos; }
 
-bool is_number(const std::string& text);
-bool is_int(const std::string& text);
+bool is_number(std::string_view text);
+bool is_int(std::string_view text);
 
-int to_int(const std::string& text, const int undefined=INT_MIN);
-long to_long(const std::string& text, const long undefined=LONG_MIN);
-float to_float(const std::string& text, const float undefined=NAN);
-double to_double(const std::string& text, const double undefined=NAN);
+int to_int(std::string_view text, const int undefined=INT_MIN);
+long to_long(std::string_view text, const long undefined=LONG_MIN);
+float to_float(std::string_view text, const float undefined=NAN);
+double to_double(std::string_view text, const double undefined=NAN);
 
+// versions for text that is not 0-terminated; undefined has no default
+// to keep calls like to_int("12", -1) unambiguous
+int to_int(const char* text, size_t length, const int undefined);
+long to_long(const char* text, size_t length, const long undefined);
+float to_float(const char* text, size_t length, const float undefined);
+double to_double(const char* text, size_t length, const double undefined);
+
+/// ASCII case conversion, other bytes are unchanged
 std::string to_lower(const std::string& text);
+std::string to_lower(std::string&& text);
+void to_lower_inplace(std::string& text);
 std::string to_upper(const std::string& text);
+std::string to_upper(std::string&& text);
+void to_upper_inplace(std::string& text);
 
+/// ASCII and ISO 8859-1 case conversion
 std::string to_upper_latin1(const std::string& text);
+std::string to_upper_latin1(std::string&& text);
+void to_upper_latin1_inplace(std::string& text);
 std::string to_lower_latin1(const std::string& text);
+std::string to_lower_latin1(std::string&& text);
+void to_lower_latin1_inplace(std::string& text);
+
+/// UTF-8 case conversion for ASCII and common European letters, see miCharTransform.h
+std::string to_upper_utf8(const std::string& text);
+std::string to_upper_utf8(std::string&& text);
+void to_upper_utf8_inplace(std::string& text);
+std::string to_lower_utf8(const std::string& text);
+std::string to_lower_utf8(std::string&& text);
+void to_lower_utf8_inplace(std::string& text);
 
 /** Appends b to a, with separator inbetween if a is not empty; returns a if b is empty. */
 std::string appended(const std::string& a, const std::string& separator, const std::string& b);
+std::string appended(std::string&& a, const std::string& separator, const std::string& b);
 void appendTo(std::string& a, const std::string& separator, const std::string& b);
 
 } // namespace miutil
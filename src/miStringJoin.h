@@ -0,0 +1,120 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PUTOOLS_MISTRINGJOIN_H
+#define PUTOOLS_MISTRINGJOIN_H
+
+#include "miStringFunctions.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace miutil {
+
+/*! Join a range of strings with a delimiter.
+ *
+ * The elements may be anything convertible to std::string_view, e.g.
+ * std::string, miString, const char* or std::string_view. The range is
+ * traversed twice: once to calculate the exact length of the result,
+ * which is then allocated once, and once to copy the text.
+ */
+template<class Range>
+std::string join(const Range& strings, std::string_view delimiter=" ")
+{
+    std::size_t count = 0, length = 0;
+    for (const auto& s : strings) {
+        length += std::string_view(s).size();
+        count += 1;
+    }
+    std::string joined;
+    if (count == 0)
+        return joined;
+    joined.reserve(length + (count - 1) * delimiter.size());
+    bool first = true;
+    for (const auto& s : strings) {
+        if (!first)
+            joined.append(delimiter);
+        joined.append(std::string_view(s));
+        first = false;
+    }
+    return joined;
+}
+
+/*! Join a range of numbers with a delimiter.
+ *
+ * Integers are formatted with std::to_chars, floating point numbers like
+ * from_number(d, prec). The result is allocated once with room for the
+ * longest possible text of each number, and shrunk afterwards without
+ * reallocation.
+ */
+template<class Range>
+std::string join_numbers(const Range& numbers, std::string_view delimiter=" ", int prec=-1)
+{
+    typedef typename std::decay<decltype(*std::begin(numbers))>::type T;
+    static_assert(std::is_arithmetic<T>::value, "join_numbers needs a range of numbers");
+    const std::size_t max_chars = std::is_integral<T>::value
+        ? (std::numeric_limits<T>::digits10 + 2) // sign and one more digit
+        : ((prec < 0) ? 32 : (prec + 8));        // like format_number
+
+    std::size_t count = 0;
+    for (auto it = std::begin(numbers); it != std::end(numbers); ++it)
+        count += 1;
+    std::string joined;
+    if (count == 0)
+        return joined;
+    joined.resize(count * (max_chars + delimiter.size()));
+
+    char* const begin = &joined[0];
+    char* out = begin;
+    char* const last = begin + joined.size();
+    bool first = true;
+    for (const T& n : numbers) {
+        if (!first)
+            out = std::copy(delimiter.begin(), delimiter.end(), out);
+        if constexpr (std::is_same<T, bool>::value)
+            *out++ = n ? '1' : '0';
+        else if constexpr (std::is_integral<T>::value)
+            out = std::to_chars(out, last, n).ptr;
+        else if constexpr (std::is_same<T, float>::value)
+            out = format_number(out, last, n, prec);
+        else
+            out = format_number(out, last, static_cast<double>(n), prec);
+        first = false;
+    }
+    joined.resize(out - begin);
+    return joined;
+}
+
+} // namespace miutil
+
+#endif // PUTOOLS_MISTRINGJOIN_H
@@ -0,0 +1,267 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+
+#include "miStringPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace miutil {
+
+namespace {
+typedef detail::PooledEntry Entry;
+
+const std::size_t MIN_BLOCK_SIZE = 1 << 10;
+const std::size_t MAX_BLOCK_SIZE = 1 << 16;
+const std::size_t INITIAL_SLOTS = 64;
+const std::size_t BULK_SIZE = 64; // tokens per lock in the bulk intern
+
+inline std::size_t text_hash(std::string_view text)
+{
+  return std::hash<std::string_view>()(text);
+}
+
+inline bool same(const Entry* e, std::string_view text, std::size_t hash)
+{
+  return e->hash == hash && e->size == text.size()
+      && std::memcmp(e->chars(), text.data(), text.size()) == 0;
+}
+} // namespace
+
+struct StringPool::Shard {
+  mutable std::mutex mutex;
+  std::vector<const Entry*> slots; // open addressing, size is a power of 2
+  std::size_t count = 0;
+  std::vector<std::unique_ptr<char[]>> blocks;
+  char* next = nullptr;
+  std::size_t left = 0;
+  std::size_t allocated = 0;
+
+  const Entry* find(std::string_view text, std::size_t hash) const;
+  const Entry* intern(std::string_view text, std::size_t hash);
+
+private:
+  void grow();
+  char* allocate(std::size_t bytes);
+};
+
+const Entry* StringPool::Shard::find(std::string_view text, std::size_t hash) const
+{
+  if (slots.empty())
+    return nullptr;
+  const std::size_t mask = slots.size() - 1;
+  for (std::size_t i = hash & mask; slots[i]; i = (i + 1) & mask) {
+    if (same(slots[i], text, hash))
+      return slots[i];
+  }
+  return nullptr;
+}
+
+const Entry* StringPool::Shard::intern(std::string_view text, std::size_t hash)
+{
+  if (2*(count + 1) > slots.size())
+    grow();
+
+  const std::size_t mask = slots.size() - 1;
+  std::size_t i = hash & mask;
+  for (; slots[i]; i = (i + 1) & mask) {
+    if (same(slots[i], text, hash))
+      return slots[i];
+  }
+
+  char* memory = allocate(sizeof(Entry) + text.size() + 1);
+  Entry* e = new (memory) Entry;
+  e->hash = hash;
+  e->size = text.size();
+  char* chars = memory + sizeof(Entry);
+  std::memcpy(chars, text.data(), text.size());
+  chars[text.size()] = 0;
+
+  slots[i] = e;
+  count += 1;
+  return e;
+}
+
+void StringPool::Shard::grow()
+{
+  std::vector<const Entry*> old(std::max(INITIAL_SLOTS, 2*slots.size()), nullptr);
+  old.swap(slots);
+  const std::size_t mask = slots.size() - 1;
+  for (const Entry* e : old) {
+    if (e) {
+      std::size_t i = e->hash & mask;
+      while (slots[i])
+        i = (i + 1) & mask;
+      slots[i] = e;
+    }
+  }
+}
+
+char* StringPool::Shard::allocate(std::size_t bytes)
+{
+  const std::size_t align = alignof(Entry);
+  bytes = (bytes + align - 1) & ~(align - 1);
+  if (bytes > left) {
+    // small blocks first, as a pool is often used for a few short strings
+    const std::size_t block_size = std::min(MAX_BLOCK_SIZE, std::max(MIN_BLOCK_SIZE, allocated));
+    if (bytes > block_size || bytes > MAX_BLOCK_SIZE / 4) {
+      // long text in a block of its own, keep using the current block
+      blocks.emplace_back(new char[bytes]);
+      allocated += bytes;
+      return blocks.back().get();
+    }
+    blocks.emplace_back(new char[block_size]);
+    allocated += block_size;
+    next = blocks.back().get();
+    left = block_size;
+  }
+  char* memory = next;
+  next += bytes;
+  left -= bytes;
+  return memory;
+}
+
+StringPool::StringPool()
+  : shards_(new Shard[SHARDS])
+{
+}
+
+StringPool::~StringPool()
+{
+}
+
+PooledString StringPool::intern(std::string_view text)
+{
+  if (text.empty())
+    return PooledString();
+  const std::size_t hash = text_hash(text);
+  Shard& shard = shards_[shard_index(hash)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return PooledString(shard.intern(text, hash));
+}
+
+PooledString StringPool::find(std::string_view text) const
+{
+  if (text.empty())
+    return PooledString();
+  const std::size_t hash = text_hash(text);
+  const Shard& shard = shards_[shard_index(hash)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return PooledString(shard.find(text, hash));
+}
+
+void StringPool::intern(const std::string_view* tokens, std::size_t count, PooledString* out)
+{
+  if (count < SHARDS) {
+    // too few tokens to save locks by sorting them by shard
+    for (std::size_t i=0; i<count; ++i)
+      out[i] = intern(tokens[i]);
+    return;
+  }
+
+  std::size_t hashes[BULK_SIZE];
+  unsigned char shard_of[BULK_SIZE];
+  unsigned char order[BULK_SIZE]; // token indices sorted by shard
+  for (std::size_t begin=0; begin<count; begin += BULK_SIZE) {
+    const std::size_t n = std::min(count - begin, BULK_SIZE);
+    const std::string_view* chunk = tokens + begin;
+
+    std::size_t starts[SHARDS + 1] = { 0 };
+    for (std::size_t i=0; i<n; ++i) {
+      out[begin + i] = PooledString();
+      if (!chunk[i].empty()) {
+        hashes[i] = text_hash(chunk[i]);
+        shard_of[i] = shard_index(hashes[i]);
+        starts[shard_of[i] + 1] += 1;
+      }
+    }
+    for (std::size_t s=0; s<SHARDS; ++s)
+      starts[s + 1] += starts[s];
+    std::size_t fill[SHARDS];
+    std::copy(starts, starts + SHARDS, fill);
+    for (std::size_t i=0; i<n; ++i) {
+      if (!chunk[i].empty())
+        order[fill[shard_of[i]]++] = i;
+    }
+
+    for (std::size_t s=0; s<SHARDS; ++s) {
+      if (starts[s] == starts[s + 1])
+        continue;
+      Shard& shard = shards_[s];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (std::size_t k=starts[s]; k<starts[s + 1]; ++k) {
+        const std::size_t i = order[k];
+        out[begin + i] = PooledString(shard.intern(chunk[i], hashes[i]));
+      }
+    }
+  }
+}
+
+std::vector<PooledString> StringPool::intern(const TokenBuffer& tokens)
+{
+  std::vector<PooledString> pooled(tokens.size());
+  if (tokens.size() < SHARDS) {
+    for (std::size_t i=0; i<tokens.size(); ++i)
+      pooled[i] = intern(tokens[i]);
+    return pooled;
+  }
+
+  std::string_view views[BULK_SIZE];
+  for (std::size_t begin=0; begin<tokens.size(); begin += BULK_SIZE) {
+    const std::size_t n = std::min(tokens.size() - begin, std::size_t(BULK_SIZE));
+    for (std::size_t i=0; i<n; ++i)
+      views[i] = tokens[begin + i];
+    intern(views, n, pooled.data() + begin);
+  }
+  return pooled;
+}
+
+std::size_t StringPool::size() const
+{
+  std::size_t n = 0;
+  for (std::size_t s=0; s<SHARDS; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    n += shards_[s].count;
+  }
+  return n;
+}
+
+std::size_t StringPool::memory() const
+{
+  std::size_t n = 0;
+  for (std::size_t s=0; s<SHARDS; ++s) {
+    std::lock_guard<std::mutex> lock(shards_[s].mutex);
+    n += shards_[s].allocated + shards_[s].slots.capacity() * sizeof(const Entry*);
+  }
+  return n;
+}
+
+} // namespace miutil
@@ -0,0 +1,158 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+
+#ifndef PUTOOLS_MISTRINGPOOL_H
+#define PUTOOLS_MISTRINGPOOL_H
+
+#include "miStringSplit.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miutil {
+
+namespace detail {
+// text of an interned string; the characters and a '\0' follow the header
+struct PooledEntry {
+  std::size_t hash;
+  std::size_t size;
+
+  const char* chars() const
+    { return reinterpret_cast<const char*>(this + 1); }
+};
+} // namespace detail
+
+/**
+ * Handle to a string interned in a StringPool.
+ *
+ * Handles from the same pool are equal if and only if their texts are
+ * equal, so == is a pointer comparison, and hash() returns the value
+ * computed when the string was interned. The text stays valid as long as
+ * the pool. A default-constructed handle is the empty string.
+ */
+class PooledString {
+public:
+  PooledString()
+    : entry_(nullptr) {}
+
+  std::string_view view() const
+    { return entry_ ? std::string_view(entry_->chars(), entry_->size) : std::string_view(); }
+  operator std::string_view() const
+    { return view(); }
+  std::string str() const
+    { return std::string(view()); }
+  const char* c_str() const
+    { return entry_ ? entry_->chars() : ""; }
+
+  std::size_t size() const
+    { return entry_ ? entry_->size : 0; }
+  bool empty() const
+    { return entry_ == nullptr; }
+  std::size_t hash() const
+    { return entry_ ? entry_->hash : 0; }
+
+  bool operator==(PooledString other) const
+    { return entry_ == other.entry_; }
+  bool operator!=(PooledString other) const
+    { return entry_ != other.entry_; }
+  /// orders by text, like std::string
+  bool operator<(PooledString other) const
+    { return entry_ != other.entry_ && view() < other.view(); }
+
+private:
+  explicit PooledString(const detail::PooledEntry* entry)
+    : entry_(entry) {}
+
+  const detail::PooledEntry* entry_;
+
+  friend class StringPool;
+};
+
+/**
+ * Thread-safe pool of interned strings.
+ *
+ * Each distinct text is stored once, in large blocks that are only freed
+ * with the pool. Interning takes the lock of one of several shards,
+ * chosen by the hash, so that threads interning different strings
+ * rarely wait for each other.
+ */
+class StringPool {
+public:
+  StringPool();
+  ~StringPool();
+
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  /// the handle for text, adding text to the pool if necessary
+  PooledString intern(std::string_view text);
+
+  /// the handle for text, or the empty handle if text is not in the pool
+  PooledString find(std::string_view text) const;
+
+  /**
+   * Intern count tokens, e.g. the fields of a record, locking each
+   * shard at most once. out must have room for count handles.
+   */
+  void intern(const std::string_view* tokens, std::size_t count, PooledString* out);
+
+  /// intern the tokens of a TokenBuffer, e.g. filled by split_into
+  std::vector<PooledString> intern(const TokenBuffer& tokens);
+
+  /// number of distinct non-empty strings in the pool
+  std::size_t size() const;
+
+  /// bytes allocated for texts and hash tables
+  std::size_t memory() const;
+
+private:
+  struct Shard;
+  enum { SHARD_BITS = 4, SHARDS = 1 << SHARD_BITS };
+
+  static std::size_t shard_index(std::size_t hash)
+    { return hash >> (8*sizeof(std::size_t) - SHARD_BITS); }
+
+  std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace miutil
+
+namespace std {
+template<>
+struct hash<miutil::PooledString> {
+  std::size_t operator()(miutil::PooledString s) const
+    { return s.hash(); }
+};
+} // namespace std
+
+#endif // PUTOOLS_MISTRINGPOOL_H
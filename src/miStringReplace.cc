@@ -0,0 +1,148 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miStringReplace.h"
+
+#include <algorithm>
+
+namespace miutil {
+
+Replacer::Replacer(std::initializer_list<std::string_view> patterns)
+{
+  compile(patterns.begin(), patterns.size());
+}
+
+Replacer::Replacer(const std::vector<std::string>& patterns)
+{
+  const std::vector<std::string_view> views(patterns.begin(), patterns.end());
+  compile(views.data(), views.size());
+}
+
+Replacer::Replacer(const std::vector<std::string_view>& patterns)
+{
+  compile(patterns.data(), patterns.size());
+}
+
+void Replacer::compile(const std::string_view* patterns, std::size_t count)
+{
+  // bytes not used in any pattern share class 0, which has no transitions
+  std::fill(classes_, classes_ + 256, 0);
+  nclasses_ = 1;
+  for (std::size_t i=0; i<count; ++i) {
+    for (char c : patterns[i]) {
+      std::uint16_t& cls = classes_[static_cast<unsigned char>(c)];
+      if (cls == 0)
+        cls = nclasses_++;
+    }
+  }
+
+  next_.assign(nclasses_, 0);
+  accept_.assign(1, NO_PATTERN);
+  lengths_.resize(count);
+  for (std::size_t i=0; i<count; ++i) {
+    const std::string_view p = patterns[i];
+    lengths_[i] = p.size();
+    if (p.empty())
+      continue;
+    first_.add(p[0]);
+    int node = 0;
+    for (char c : p) {
+      const std::size_t edge = node * nclasses_ + classes_[static_cast<unsigned char>(c)];
+      if (next_[edge] == 0) {
+        next_[edge] = accept_.size();
+        accept_.push_back(NO_PATTERN);
+        next_.resize(next_.size() + nclasses_, 0);
+      }
+      node = next_[edge];
+    }
+    if (accept_[node] == NO_PATTERN)
+      accept_[node] = i;
+  }
+}
+
+std::size_t Replacer::find(std::string_view text, std::size_t pos, int& pattern) const
+{
+  const std::size_t len = text.size();
+  while ((pos = first_.find_first_in(text, pos)) != std::string_view::npos) {
+    pattern = NO_PATTERN;
+    int node = 0;
+    for (std::size_t i = pos; i < len; ++i) {
+      node = next(node, text[i]);
+      if (node == 0)
+        break;
+      if (accept_[node] != NO_PATTERN)
+        pattern = accept_[node];
+    }
+    if (pattern != NO_PATTERN)
+      return pos;
+    pos += 1;
+  }
+  pattern = NO_PATTERN;
+  return std::string_view::npos;
+}
+
+void Replacer::replace(std::string_view text, std::string& out, const std::string_view* replacements) const
+{
+  // first pass to find the output size
+  std::size_t size = text.size(), pos = 0;
+  int pattern;
+  for (std::size_t hit = find(text, pos, pattern); hit != std::string_view::npos; hit = find(text, pos, pattern)) {
+    size += replacements[pattern].size();
+    size -= lengths_[pattern];
+    pos = hit + lengths_[pattern];
+  }
+  out.reserve(out.size() + size);
+
+  replace(text, out, [replacements](int p, std::string& o) { o += replacements[p]; });
+}
+
+namespace {
+std::vector<std::string_view> pair_members(std::initializer_list<ReplacePair> pairs, bool first)
+{
+  std::vector<std::string_view> members;
+  members.reserve(pairs.size());
+  for (const ReplacePair& p : pairs)
+    members.push_back(first ? p.first : p.second);
+  return members;
+}
+} // namespace
+
+std::string replace_all(std::string_view text, std::initializer_list<ReplacePair> pairs)
+{
+  const Replacer replacer(pair_members(pairs, true));
+  return replacer.replace(text, pair_members(pairs, false).data());
+}
+
+void replace_all_inplace(std::string& text, std::initializer_list<ReplacePair> pairs)
+{
+  const Replacer replacer(pair_members(pairs, true));
+  int pattern;
+  if (replacer.find(text, 0, pattern) != std::string::npos)
+    text = replacer.replace(text, pair_members(pairs, false).data());
+}
+
+} // namespace miutil
@@ -0,0 +1,133 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MISTRINGREPLACE_H
+#define PUTOOLS_MISTRINGREPLACE_H
+
+#include "miCharSet.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace miutil {
+
+/**
+ * A set of patterns that are replaced in one pass over a text.
+ *
+ * The patterns are compiled into a trie once, so the same Replacer
+ * can be used for many texts. At each position the longest matching
+ * pattern is replaced, and the scan continues after it; replacement
+ * text is never scanned again. Positions where no pattern can start
+ * are skipped with a CharSet search for the first pattern bytes.
+ */
+class Replacer {
+public:
+  enum { NO_PATTERN = -1 };
+
+  /// empty patterns are ignored; for duplicates, the first one is used
+  explicit Replacer(std::initializer_list<std::string_view> patterns);
+  explicit Replacer(const std::vector<std::string>& patterns);
+  explicit Replacer(const std::vector<std::string_view>& patterns);
+
+  /// number of patterns, including ignored ones
+  std::size_t size() const
+    { return lengths_.size(); }
+
+  /// length of pattern i
+  std::size_t length(int pattern) const
+    { return lengths_[pattern]; }
+
+  /**
+   * Find the first match at or after pos.
+   * \param pattern set to the index of the matching pattern, or NO_PATTERN
+   * \return the position of the match, or npos
+   */
+  std::size_t find(std::string_view text, std::size_t pos, int& pattern) const;
+
+  /**
+   * Append text to out, with pattern i replaced by replacements[i].
+   * The output is allocated once, with the exact size.
+   */
+  void replace(std::string_view text, std::string& out, const std::string_view* replacements) const;
+
+  std::string replace(std::string_view text, const std::string_view* replacements) const
+    { std::string out; replace(text, out, replacements); return out; }
+
+  /**
+   * Append text to out, calling append_replacement(int pattern, std::string& out)
+   * for each match. Replacements are only computed when the pattern occurs.
+   */
+  template<class F>
+  void replace(std::string_view text, std::string& out, F&& append_replacement) const;
+
+private:
+  void compile(const std::string_view* patterns, std::size_t count);
+
+  int next(int node, char c) const
+    { return next_[node * nclasses_ + classes_[static_cast<unsigned char>(c)]]; }
+
+private:
+  CharSet first_;
+  std::uint16_t classes_[256]; //!< byte -> class, up to 256 classes plus class 0
+  int nclasses_;
+  std::vector<int> next_;    //!< node * nclasses_ + class -> node, 0 if none
+  std::vector<int> accept_;  //!< node -> pattern ending there, or NO_PATTERN
+  std::vector<std::size_t> lengths_;
+};
+
+template<class F>
+void Replacer::replace(std::string_view text, std::string& out, F&& append_replacement) const
+{
+  std::size_t pos = 0;
+  int pattern;
+  for (std::size_t hit = find(text, pos, pattern); hit != std::string_view::npos; hit = find(text, pos, pattern)) {
+    out.append(text.data() + pos, hit - pos);
+    append_replacement(pattern, out);
+    pos = hit + lengths_[pattern];
+  }
+  out.append(text.data() + pos, text.size() - pos);
+}
+
+typedef std::pair<std::string_view, std::string_view> ReplacePair;
+
+/**
+ * Replace all occurrences of the first member of each pair by the
+ * second member, in one pass (see Replacer). For repeated use with the
+ * same patterns, keep a Replacer object instead.
+ */
+std::string replace_all(std::string_view text, std::initializer_list<ReplacePair> pairs);
+
+/// like replace_all, but modifying text
+void replace_all_inplace(std::string& text, std::initializer_list<ReplacePair> pairs);
+
+} // namespace miutil
+
+#endif // PUTOOLS_MISTRINGREPLACE_H
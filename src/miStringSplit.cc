@@ -0,0 +1,290 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miStringSplit.h"
+
+namespace miutil {
+
+namespace {
+bool contains_all(const CharSet& set, const char* chars)
+{
+  for (; *chars; ++chars) {
+    if (!set.contains(*chars))
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+SplitViews::SplitViews(std::string_view text, int nos, const char* separator_chars, bool clean)
+  : text_(text)
+  , separators_(CharSet(separator_chars), text)
+  , nos_(nos)
+  , count_(0)
+  , pos_(0)
+  , clean_(clean)
+  , trim_(clean && !contains_all(separators_.charset(), whitespaces))
+  , rest_(false)
+{
+}
+
+bool SplitViews::next(std::string_view& token)
+{
+  const std::size_t len = text_.size();
+  while (pos_ < len) {
+    if (rest_) {
+      // split limit reached, everything after the last separator is one token
+      token = text_.substr(pos_);
+      pos_ = len;
+      if (clean_)
+        token = trimmed_view(token);
+      return !(clean_ && token.empty());
+    }
+
+    std::size_t start = pos_;
+    if (clean_) {
+      start = separators_.find_first_not_in(start);
+      if (start == std::string_view::npos)
+        break;
+    }
+    std::size_t stop = separators_.find_first_in(start);
+    if (stop == std::string_view::npos)
+      stop = len;
+    pos_ = stop + 1;
+    if (nos_ && ++count_ >= nos_)
+      rest_ = true;
+
+    token = text_.substr(start, stop - start);
+    if (!trim_)
+      return true; // not cleaning, or all whitespace is separator
+    token = trimmed_view(token);
+    if (!token.empty())
+      return true;
+  }
+  pos_ = len;
+  return false;
+}
+
+SplitProtection::SplitProtection()
+  : escape_(0)
+  , has_escape_(false)
+  , nested_(false)
+{
+  std::fill(rights_, rights_ + 256, 0);
+}
+
+SplitProtection::SplitProtection(char left, char right)
+  : SplitProtection()
+{
+  add(left, right);
+}
+
+SplitProtection& SplitProtection::add(char left, char right)
+{
+  lefts_.add(left);
+  rights_[static_cast<unsigned char>(left)] = right;
+  specials_ += left;
+  specials_ += right;
+  return *this;
+}
+
+SplitProtection& SplitProtection::escape(char e)
+{
+  escape_ = e;
+  has_escape_ = true;
+  specials_ += e;
+  return *this;
+}
+
+namespace {
+CharSet with_specials(const char* separator_chars, const SplitProtection& protection)
+{
+  CharSet set(separator_chars);
+  for (char c : protection.specials())
+    set.add(c);
+  return set;
+}
+} // namespace
+
+ProtectedSplitViews::ProtectedSplitViews(std::string_view text, char left, char right,
+    const char* separator_chars, bool clean)
+  : ProtectedSplitViews(text, SplitProtection(left, right), separator_chars, clean)
+{
+}
+
+ProtectedSplitViews::ProtectedSplitViews(std::string_view text, const SplitProtection& protection,
+    const char* separator_chars, bool clean)
+  : text_(text)
+  , protection_(protection)
+  , separators_(CharSet(separator_chars), text)
+  , specials_(with_specials(separator_chars, protection), text)
+  , pos_(0)
+  , clean_(clean)
+{
+}
+
+std::size_t ProtectedSplitViews::find_stop(std::size_t p)
+{
+  const CharSet& separators = separators_.charset();
+  open_.clear();
+  while ((p = specials_.find_first_in(p)) != std::string_view::npos) {
+    const char c = text_[p];
+    if (protection_.has_escape() && c == protection_.escape()) {
+      p += 2;
+      continue;
+    }
+    if (open_.empty()) {
+      // a character that is both separator and border is a separator here
+      if (separators.contains(c))
+        return p;
+      if (protection_.is_left(c))
+        open_ += protection_.right(c);
+    } else {
+      const char right = open_.back();
+      if (c == right)
+        open_.pop_back();
+      else if (protection_.is_nested() && protection_.is_left(c) && !protection_.is_quote(right))
+        open_ += protection_.right(c);
+    }
+    p += 1;
+  }
+  return open_.empty() ? text_.size() : std::string_view::npos;
+}
+
+bool ProtectedSplitViews::next(std::string_view& token)
+{
+  const std::size_t len = text_.size();
+  while (pos_ < len) {
+    std::size_t start = pos_;
+    if (clean_) {
+      start = separators_.find_first_not_in(start);
+      if (start == std::string_view::npos)
+        break;
+    }
+
+    const std::size_t stop = find_stop(start);
+    if (stop == std::string_view::npos) {
+      // unbalanced border, give up
+      break;
+    }
+    pos_ = stop + 1;
+
+    token = text_.substr(start, stop - start);
+    if (!clean_)
+      return true;
+    token = trimmed_view(token);
+    if (!token.empty())
+      return true;
+  }
+  pos_ = len;
+  return false;
+}
+
+std::vector<std::string> split_protected(std::string_view text, const SplitProtection& protection,
+    const char* separator_chars, bool clean)
+{
+  std::vector<std::string> vec;
+  ProtectedSplitViews splitter(text, protection, separator_chars, clean);
+  for (std::string_view token; splitter.next(token); )
+    vec.emplace_back(token);
+  return vec;
+}
+
+// ------------------------------------------------------------------------
+
+TokenBuffer::TokenBuffer(const TokenBuffer& other)
+  : size_(0)
+  , capacity_(0)
+{
+  *this = other;
+}
+
+TokenBuffer& TokenBuffer::operator=(const TokenBuffer& other)
+{
+  if (this != &other) {
+    size_ = 0;
+    reserve(other.size_);
+    if (other.size_)
+      std::memcpy(chars_.get(), other.chars_.get(), other.size_);
+    size_ = other.size_;
+    ends_ = other.ends_;
+  }
+  return *this;
+}
+
+TokenBuffer::TokenBuffer(TokenBuffer&& other) noexcept
+  : size_(0)
+  , capacity_(0)
+{
+  *this = std::move(other);
+}
+
+TokenBuffer& TokenBuffer::operator=(TokenBuffer&& other) noexcept
+{
+  if (this != &other) {
+    chars_ = std::move(other.chars_);
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    ends_ = std::move(other.ends_);
+    other.size_ = other.capacity_ = 0;
+    other.ends_.clear();
+  }
+  return *this;
+}
+
+void TokenBuffer::reserve(std::size_t chars)
+{
+  if (chars <= capacity_)
+    return;
+  std::unique_ptr<char[]> bigger(new char[chars]);
+  if (size_)
+    std::memcpy(bigger.get(), chars_.get(), size_);
+  chars_ = std::move(bigger);
+  capacity_ = chars;
+}
+
+std::vector<std::string> TokenBuffer::strings() const
+{
+  std::vector<std::string> tokens;
+  tokens.reserve(size());
+  for (std::string_view t : *this)
+    tokens.emplace_back(t);
+  return tokens;
+}
+
+std::size_t split_into(TokenBuffer& buffer, std::string_view text, int nos,
+    const char* separator_chars, bool clean)
+{
+  buffer.clear();
+  buffer.reserve(text.size()); // tokens are never longer than the text
+  SplitViews splitter(text, nos, separator_chars, clean);
+  for (std::string_view token; splitter.next(token); )
+    buffer.push_back(token);
+  return buffer.size();
+}
+
+} // namespace miutil
@@ -0,0 +1,403 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MISTRINGSPLIT_H
+#define PUTOOLS_MISTRINGSPLIT_H
+
+#include "miCharSet.h"
+#include "miStringFunctions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace miutil {
+
+/**
+ * Single-pass input iterator over the tokens of a splitter class
+ * providing "bool next(std::string_view&)".
+ */
+template<class Splitter>
+class TokenIterator {
+public:
+  typedef std::input_iterator_tag iterator_category;
+  typedef std::string_view value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const std::string_view* pointer;
+  typedef const std::string_view& reference;
+
+  TokenIterator()
+    : splitter_(nullptr) {}
+  explicit TokenIterator(Splitter* splitter)
+    : splitter_(splitter) { ++*this; }
+
+  reference operator*() const
+    { return token_; }
+  pointer operator->() const
+    { return &token_; }
+
+  TokenIterator& operator++()
+    { if (!splitter_->next(token_)) splitter_ = nullptr; return *this; }
+
+  bool operator==(const TokenIterator& other) const
+    { return splitter_ == other.splitter_; }
+  bool operator!=(const TokenIterator& other) const
+    { return splitter_ != other.splitter_; }
+
+private:
+  Splitter* splitter_;
+  std::string_view token_;
+};
+
+/**
+ * Splits a text into std::string_view tokens without copying.
+ *
+ * The tokens are the same as those returned by miutil::split with
+ * the same arguments, but they are produced one by one and point into
+ * the original text, which must outlive the splitter. With clean=true,
+ * trimming and removal of empty tokens happen while splitting.
+ *
+ * Iteration is single-pass: begin() starts consuming tokens.
+ */
+class SplitViews {
+public:
+  typedef TokenIterator<SplitViews> iterator;
+
+  /**
+   * \param text the text to split, must outlive this object
+   * \param nos max number of splits, 0 = split all elements; after nos
+   *        tokens, the rest of the text is returned as one token
+   * \param separator_chars characters separating tokens
+   * \param clean if true, skip repeated separators, trim tokens and drop empty ones
+   */
+  SplitViews(std::string_view text, int nos, const char* separator_chars=whitespaces, bool clean=true);
+
+  /// fetch the next token, returns false when there are no more tokens
+  bool next(std::string_view& token);
+
+  iterator begin()
+    { return iterator(this); }
+  iterator end()
+    { return iterator(); }
+
+private:
+  std::string_view text_;
+  CharSetScanner separators_;
+  int nos_;
+  int count_;
+  std::size_t pos_;
+  bool clean_;
+  bool trim_;
+  bool rest_;
+};
+
+inline SplitViews split_views(std::string_view text, int nos, const char* separator_chars=whitespaces, bool clean=true)
+{ return SplitViews(text, nos, separator_chars, clean); }
+
+inline SplitViews split_views(std::string_view text, const char* separator_chars=whitespaces, bool clean=true)
+{ return SplitViews(text, 0, separator_chars, clean); }
+
+/**
+ * Border pairs for ProtectedSplitViews.
+ *
+ * Separators between a left border and its right border do not split.
+ * Several pairs may be active at once, e.g. quotes, parentheses and
+ * brackets. Pairs with the same left and right border (quotes) protect
+ * everything up to the next quote, nothing nests inside them.
+ */
+class SplitProtection {
+public:
+  SplitProtection();
+  SplitProtection(char left, char right);
+
+  /// add a left/right border pair
+  SplitProtection& add(char left, char right);
+
+  /**
+   * Set an escape character. The character following it is never a
+   * separator or border. Tokens keep the escape characters.
+   */
+  SplitProtection& escape(char e);
+
+  /**
+   * If nested, left borders inside a protected part open another
+   * protected part, which must be closed first, e.g. "(a [b) c])" is one
+   * token with parentheses and brackets. Otherwise only the right border
+   * of the outermost left border ends the protected part.
+   */
+  SplitProtection& nested(bool n=true)
+    { nested_ = n; return *this; }
+
+  bool is_left(char c) const
+    { return lefts_.contains(c); }
+
+  /// the right border for left border c
+  char right(char c) const
+    { return rights_[static_cast<unsigned char>(c)]; }
+
+  bool is_quote(char c) const
+    { return is_left(c) && right(c) == c; }
+
+  bool has_escape() const
+    { return has_escape_; }
+
+  char escape() const
+    { return escape_; }
+
+  bool is_nested() const
+    { return nested_; }
+
+  /// all left and right borders and the escape character
+  const std::string& specials() const
+    { return specials_; }
+
+private:
+  CharSet lefts_;
+  std::string specials_;
+  char rights_[256];
+  char escape_;
+  bool has_escape_;
+  bool nested_;
+};
+
+/**
+ * Splits a text into std::string_view tokens like miutil::split_protected.
+ *
+ * Separators between a left and the matching right border character
+ * do not split, e.g. for "(a b) c" with borders '(' and ')' the tokens
+ * are "(a b)" and "c". If a left border is not closed, splitting stops
+ * at the token containing it.
+ *
+ * The text is scanned once, each character is looked at once.
+ */
+class ProtectedSplitViews {
+public:
+  typedef TokenIterator<ProtectedSplitViews> iterator;
+
+  ProtectedSplitViews(std::string_view text, char left, char right,
+      const char* separator_chars=whitespaces, bool clean=true);
+
+  ProtectedSplitViews(std::string_view text, const SplitProtection& protection,
+      const char* separator_chars=whitespaces, bool clean=true);
+
+  /// fetch the next token, returns false when there are no more tokens
+  bool next(std::string_view& token);
+
+  iterator begin()
+    { return iterator(this); }
+  iterator end()
+    { return iterator(); }
+
+private:
+  std::size_t find_stop(std::size_t start);
+
+private:
+  std::string_view text_;
+  SplitProtection protection_;
+  CharSetScanner separators_;
+  CharSetScanner specials_;
+  std::string open_; //!< right borders of the open protected parts
+  std::size_t pos_;
+  bool clean_;
+};
+
+inline ProtectedSplitViews split_protected_views(std::string_view text, char left, char right,
+    const char* separator_chars=whitespaces, bool clean=true)
+{ return ProtectedSplitViews(text, left, right, separator_chars, clean); }
+
+inline ProtectedSplitViews split_protected_views(std::string_view text, const SplitProtection& protection,
+    const char* separator_chars=whitespaces, bool clean=true)
+{ return ProtectedSplitViews(text, protection, separator_chars, clean); }
+
+/**
+ * Like miutil::split_protected, but with several border pairs, nesting
+ * and an escape character as given by protection.
+ */
+std::vector<std::string> split_protected(std::string_view text, const SplitProtection& protection,
+    const char* separator_chars=whitespaces, bool clean=true);
+
+namespace detail {
+template<class Splitter, class F>
+bool visit_tokens(Splitter& splitter, F& fn)
+{
+  for (std::string_view token; splitter.next(token); ) {
+    if constexpr (std::is_void<decltype(fn(token))>::value) {
+      fn(token);
+    } else {
+      if (!fn(token))
+        return false;
+    }
+  }
+  return true;
+}
+} // namespace detail
+
+/**
+ * Calls fn(std::string_view) for each token that miutil::split would return.
+ *
+ * If fn returns a bool, false stops the iteration and the rest of the
+ * text is not looked at.
+ *
+ * \return false if the iteration was stopped by fn
+ */
+template<class F>
+bool for_each_token(std::string_view text, const char* separator_chars, bool clean, F fn)
+{
+  SplitViews splitter(text, 0, separator_chars, clean);
+  return detail::visit_tokens(splitter, fn);
+}
+
+/**
+ * Calls fn(std::string_view) for each token that miutil::split_protected would return.
+ *
+ * Stops like the for_each_token above if fn returns false.
+ */
+template<class F>
+bool for_each_token(std::string_view text, char left, char right, const char* separator_chars, bool clean, F fn)
+{
+  ProtectedSplitViews splitter(text, left, right, separator_chars, clean);
+  return detail::visit_tokens(splitter, fn);
+}
+
+/// Calls fn(std::string_view) for each token of split_protected with several border pairs.
+template<class F>
+bool for_each_token(std::string_view text, const SplitProtection& protection, const char* separator_chars, bool clean, F fn)
+{
+  ProtectedSplitViews splitter(text, protection, separator_chars, clean);
+  return detail::visit_tokens(splitter, fn);
+}
+
+/**
+ * Tokens stored in one character buffer plus an array of end offsets.
+ *
+ * clear() keeps the capacity, so that a TokenBuffer refilled with
+ * split_into, e.g. once per line of a file, stops allocating once it
+ * has seen the longest line.
+ */
+class TokenBuffer {
+public:
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::string_view value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::string_view* pointer;
+    typedef std::string_view reference;
+
+    const_iterator(const TokenBuffer* buffer, std::size_t index)
+      : buffer_(buffer), index_(index) {}
+
+    std::string_view operator*() const
+      { return (*buffer_)[index_]; }
+
+    const_iterator& operator++()
+      { ++index_; return *this; }
+    const_iterator operator++(int)
+      { const_iterator old(*this); ++index_; return old; }
+
+    bool operator==(const const_iterator& other) const
+      { return index_ == other.index_; }
+    bool operator!=(const const_iterator& other) const
+      { return index_ != other.index_; }
+
+  private:
+    const TokenBuffer* buffer_;
+    std::size_t index_;
+  };
+
+  TokenBuffer()
+    : size_(0), capacity_(0) {}
+
+  TokenBuffer(const TokenBuffer& other);
+  TokenBuffer& operator=(const TokenBuffer& other);
+  TokenBuffer(TokenBuffer&& other) noexcept;
+  TokenBuffer& operator=(TokenBuffer&& other) noexcept;
+
+  /// remove all tokens, but keep the allocated memory
+  void clear()
+    { size_ = 0; ends_.clear(); }
+
+  /// make room for tokens with this many characters in total
+  void reserve(std::size_t chars);
+
+  void push_back(std::string_view token)
+    {
+      if (!token.empty()) {
+        if (size_ + token.size() > capacity_)
+          reserve(std::max(size_ + token.size(), 2*capacity_));
+        std::memcpy(chars_.get() + size_, token.data(), token.size());
+        size_ += token.size();
+      }
+      ends_.push_back(size_);
+    }
+
+  std::size_t size() const
+    { return ends_.size(); }
+
+  bool empty() const
+    { return ends_.empty(); }
+
+  /// the token, valid until the buffer is modified
+  std::string_view operator[](std::size_t i) const
+    { const std::size_t b = i ? ends_[i-1] : 0; return std::string_view(chars_.get() + b, ends_[i] - b); }
+
+  const_iterator begin() const
+    { return const_iterator(this, 0); }
+  const_iterator end() const
+    { return const_iterator(this, size()); }
+
+  /// copies of the tokens, as miutil::split would return them
+  std::vector<std::string> strings() const;
+
+private:
+  std::unique_ptr<char[]> chars_;
+  std::size_t size_;
+  std::size_t capacity_;
+  std::vector<std::size_t> ends_;
+};
+
+/**
+ * Replace the contents of buffer with the tokens that
+ * miutil::split(text, nos, separator_chars, clean) would return.
+ *
+ * \return the number of tokens
+ */
+std::size_t split_into(TokenBuffer& buffer, std::string_view text, int nos,
+    const char* separator_chars=whitespaces, bool clean=true);
+
+inline std::size_t split_into(TokenBuffer& buffer, std::string_view text,
+    const char* separator_chars=whitespaces, bool clean=true)
+{ return split_into(buffer, text, 0, separator_chars, clean); }
+
+} // namespace miutil
+
+#endif // PUTOOLS_MISTRINGSPLIT_H
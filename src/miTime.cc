@@ -34,8 +34,14 @@
 #endif
 
 #include "miTime.h"
+#include "miCharSet.h"
+#include "miNumberParse.h"
 #include "miString.h"
+#include "miStringSplit.h"
+#include "miTimeFormatter.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <iostream>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -47,13 +53,10 @@ namespace /*anonymous*/ {
 bool show_message()
 {
   static const int message_counter_max = 100;
-  static int message_counter = 0;
-  if (message_counter < message_counter_max) {
-    message_counter += 1;
-    return true;
-  } else {
+  static std::atomic<int> message_counter(0); // setTime may run on several threads
+  if (message_counter.load() >= message_counter_max)
     return false;
-  }
+  return message_counter.fetch_add(1) < message_counter_max;
 }
 
 void warning(const std::string& s)
@@ -70,7 +73,6 @@ void invalid(const std::string& s)
 
 const std::string YMD = "%Y-%m-%d";
 const std::string HMS = "%H:%M:%S";
-const std::string YMD_HMS = YMD + " " + HMS;
 } // anonymous namespace
 
 /* Construct miTime from UNIX time (this function has a Y2038 problem
@@ -85,63 +87,73 @@ miutil::miTime::miTime(const time_t& t)
   }
 }
 
+namespace {
+
+// fetch the first two tokens of text split at separators
+bool split_two(std::string_view text, const char* separators, std::string_view& first, std::string_view& second)
+{
+  miutil::SplitViews tokens(text, 0, separators);
+  return tokens.next(first) && tokens.next(second);
+}
+
+// scan yyyymmddhhmmss, yyyymmddhhmm, yyyymmddhh or yyyymmdd
+bool scan_compact(std::string_view str, int& yy, int& mm, int& dd, int& h, int& m, int& s)
+{
+  h = m = s = 0;
+  switch (str.size()) {
+  case 14:
+    return miutil::scan_ints(str, "%4d%2d%2d%2d%2d%2d", { &yy, &mm, &dd, &h, &m, &s }) == 6;
+  case 12:
+    return miutil::scan_ints(str, "%4d%2d%2d%2d%2d", { &yy, &mm, &dd, &h, &m }) == 5;
+  case 10:
+    return miutil::scan_ints(str, "%4d%2d%2d%2d", { &yy, &mm, &dd, &h }) == 4;
+  case 8:
+    return miutil::scan_ints(str, "%4d%2d%2d", { &yy, &mm, &dd }) == 3;
+  default:
+    return false;
+  }
+}
+
+} // anonymous namespace
+
 // make time from "yyyy-mm-dd hh:mm:ss", "yyyy-mm-dd"
 // from yyyymmddhhmmss, yyyymmddhhmm, yyyymmddhh or yyyymmdd
 void
-miutil::miTime::setTime(const std::string& st)
+miutil::miTime::setTime(std::string_view st)
 {
-  vector<std::string> t;
-  std::string str=st;
-  if(miutil::contains(str, "Z"))
-    miutil::replace(str, "Z", "");
-
-  miutil::trim(str);
+  // drop 'Z' without allocating for all but unusually long input
+  char buffer[64];
+  std::string long_str;
+  std::string_view str = st;
+  if (str.find('Z') != std::string_view::npos) {
+    char* out = buffer;
+    if (str.size() > sizeof(buffer)) {
+      long_str.resize(str.size());
+      out = &long_str[0];
+    }
+    const char* out_end = std::remove_copy(str.begin(), str.end(), out, 'Z');
+    str = std::string_view(out, out_end - out);
+  }
 
-  if(miutil::contains(str, "T"))
-    t=miutil::split(str, "T");
-  else
-    t=miutil::split(str);
+  str = miutil::trimmed_view(str);
 
-  if (t.size()>=2) {
-    Date.setDate(t[0]);
-    Clock.setClock(t[1]);
+  std::string_view t0, t1;
+  const bool has_t = (str.find('T') != std::string_view::npos);
+  if (split_two(str, has_t ? "T" : miutil::whitespaces, t0, t1)) {
+    Date.setDate(t0);
+    Clock.setClock(t1);
     return;
   }
 
-  int yy, mm, dd;
-  int h   = 0;
-  int m   = 0;
-  int s   = 0;
-  int len = str.length();
-
-  if(miutil::contains(str, "-")){
+  if (str.find('-') != std::string_view::npos) {
     Date.setDate(str);
-    Clock.setClock(h,m,s);
+    Clock.setClock(0, 0, 0);
     return;
   }
 
-  if(len==14){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d%2d%2d", &yy,&mm,&dd, &h,&m,&s)!=6){
-      invalid(str);
-      return;
-    }
-  }else if(len==12){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d%2d"   , &yy,&mm,&dd, &h,&m)!=5){
-      invalid(str);
-      return;
-    }
-  }else if(len==10){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d"      , &yy,&mm,&dd, &h)!=4){
-      invalid(str);
-      return;
-    }
-  }else if(len==8){
-    if(sscanf(str.c_str(), "%4d%2d%2d"         , &yy,&mm,&dd)!=3){
-      invalid(str);
-      return;
-    }
-  }else{
-    invalid(str);
+  int yy, mm, dd, h, m, s;
+  if (!scan_compact(str, yy, mm, dd, h, m, s)) {
+    invalid(std::string(str));
     return;
   }
 
@@ -159,48 +171,22 @@ miutil::miTime::isValid(int y, int m, int d, int h, int min, int s)
 }
 
 bool
-miutil::miTime::isValid(const std::string& st)
+miutil::miTime::isValid(std::string_view st)
 {
-  vector<std::string> t=miutil::split(st);
-  if ( t.size() < 2 ) {
-    t=miutil::split(st, "T");
-    if ( t.size() < 2  ) {
-      t=miutil::split(st, "t");
-    }
-  }
-
-  if (t.size()>=2) {
-    if(!miutil::miDate::isValid(t[0]))
+  std::string_view t0, t1;
+  if (split_two(st, miutil::whitespaces, t0, t1) || split_two(st, "T", t0, t1) || split_two(st, "t", t0, t1)) {
+    if(!miutil::miDate::isValid(t0))
       return false;
-    return miutil::miClock::isValid(t[1]);
+    return miutil::miClock::isValid(t1);
   }
 
-  int yy, mm, dd;
-  int h  = 0;
-  int m  = 0;
-  int s  = 0;
-
-  std::string str=st;
+  const std::string_view str = miutil::trimmed_view(st);
 
-  miutil::trim(str);
-  int len = str.length();
-
-  if(miutil::contains(str, "-"))
+  if (str.find('-') != std::string_view::npos)
     return miutil::miClock::isValid(str);
 
-  if(len==14){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d%2d%2d", &yy,&mm,&dd, &h,&m,&s)!=6)
-      return false;
-  }else if(len==12){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d%2d"   , &yy,&mm,&dd, &h,&m)!=5)
-      return false;
-  }else if(len==10){
-    if(sscanf(str.c_str(), "%4d%2d%2d%2d"      , &yy,&mm,&dd, &h)!=4)
-      return false;
-  }else if(len==8) {
-    if(sscanf(str.c_str(), "%4d%2d%2d"         , &yy,&mm,&dd)!=3)
-      return false;
-  }else
+  int yy, mm, dd, h, m, s;
+  if (!scan_compact(str, yy, mm, dd, h, m, s))
     return false;
 
   return isValid(yy,mm,dd,h,m,s);
@@ -430,83 +416,13 @@ miutil::miTime::format(const std::string& nt, const std::string& lang) const
 
 std::string miutil::miTime::format(const std::string& nt, const std::string& lang, bool utf8) const
 {
-  std::string newTime(nt), l(lang);
-  miutil::replace(newTime, "%c", "%a %b %d %X GMT %Y");
+  detail::TimeFormatPreparation prepared;
+  detail::prepare_time_format(nt, lang, Clock.sec() != 0, Clock.min() != 0, prepared);
 
   miTime ftim(Date, Clock);
+  detail::apply_time_shifts(ftim, prepared.shifts);
 
-  vector<std::string> token, remove;
-
-  if (miutil::contains(newTime, "$")) {
-    token = miutil::split(newTime);
-
-    for (unsigned int i = 0; i < token.size(); i++) {
-      if (miutil::contains(token[i], "$")) {
-
-        std::string::size_type k;
-        if ((k = token[i].find("$tz=")) != string::npos) {
-          token[i] = token[i].substr(k + 4);
-          miutil::replace(newTime, "%tz", token[i]);
-          ftim.addHour(ftim.timezone(token[i]));
-          remove.push_back("$tz=" + token[i]);
-        }
-        if (miutil::contains(token[i], "$dst")) {
-          ftim.addHour(ftim.dst());
-          remove.push_back("$dst");
-        }
-        if (miutil::contains(token[i], "$time")) {
-          miutil::replace(newTime, token[i], YMD_HMS);
-        }
-        if (miutil::contains(token[i], "$date")) {
-          miutil::replace(newTime, token[i], YMD);
-        }
-        if (miutil::contains(token[i], "$clock")) {
-          miutil::replace(newTime, token[i], HMS);
-        }
-        if (miutil::contains(token[i], "$autoclock")) {
-          if (Clock.sec() != 0)
-            miutil::replace(newTime, token[i], HMS);
-          else if (Clock.min() != 0)
-            miutil::replace(newTime, token[i], "%H:%M");
-          else
-            miutil::replace(newTime, token[i], "%H");
-        }
-        if (miutil::contains(token[i], "$miniclock")) {
-          if (Clock.min() != 0)
-            miutil::replace(newTime, token[i], "%H:%M");
-          else
-            miutil::replace(newTime, token[i], "%H");
-        }
-        if ((k = token[i].find("$lg=")) != string::npos) {
-          token[i] = token[i].substr(k + 4);
-          if (miutil::contains(token[i], "nor"))
-            l = "no";
-          else if (miutil::contains(token[i], "eng"))
-            l = "en";
-          else if (miutil::contains(token[i], "swe"))
-            l = "se";
-          else
-            l = token[i];
-          remove.push_back("$lg=" + token[i]);
-        }
-
-        if (remove.size()) {
-          for (unsigned int n = 0; n < remove.size(); n++) {
-            std::string rm1 = " " + remove[n];
-            std::string rm2 = remove[n] + " ";
-            if (miutil::contains(newTime, rm1))
-              miutil::replace(newTime, rm1, "");
-            else if (miutil::contains(newTime, rm2))
-              miutil::replace(newTime, rm2, "");
-            else
-              miutil::replace(newTime, remove[n], "");
-          }
-          remove.clear();
-        }
-      }
-    }
-  }
-
+  std::string& newTime = prepared.format;
   if (miutil::contains(newTime, "$midnight24")) {
     if (ftim.clock().isoClock() == "00:00:00") {
       ftim.addDay(-1);
@@ -517,7 +433,7 @@ std::string miutil::miTime::format(const std::string& nt, const std::string& lan
     }
   }
 
-  newTime = ftim.date().format(newTime, l, utf8);
+  newTime = ftim.date().format(newTime, prepared.lang, utf8);
   newTime = ftim.clock().format(newTime);
   return newTime;
 }
@@ -55,9 +55,7 @@ public:
     Date(d),
     Clock(c) {}
   explicit miTime(const time_t&);
-  explicit miTime(const char* s)
-  { setTime(s); }
-  explicit miTime(const std::string& s)
+  explicit miTime(std::string_view s)
   { setTime(s); }
 
   bool undef() const
@@ -67,10 +65,10 @@ public:
   { Date.setDate(y,m,d); Clock.setClock(h,min,s); }
   void setTime(const miDate& d, const miClock& c)
   { Date=d; Clock=c; }
-  void setTime(const std::string&);
+  void setTime(std::string_view);
 
   static bool isValid(int, int, int, int, int =0, int =0);
-  static bool isValid(const std::string&);
+  static bool isValid(std::string_view);
 
   miDate date() const
   { return Date; }
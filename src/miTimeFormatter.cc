@@ -0,0 +1,420 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+
+#include "miTimeFormatter.h"
+
+#include "miCharTransform.h"
+#include "miString.h"
+#include "miStringReplace.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace miutil {
+
+namespace {
+const std::string YMD = "%Y-%m-%d";
+const std::string HMS = "%H:%M:%S";
+const std::string YMD_HMS = YMD + " " + HMS;
+} // namespace
+
+namespace detail {
+
+void prepare_time_format(const std::string& format, const std::string& lang,
+    bool has_sec, bool has_min, TimeFormatPreparation& prepared)
+{
+  std::string& newTime = prepared.format;
+  std::string& l = prepared.lang;
+  newTime = format;
+  l = lang;
+  prepared.shifts.clear();
+
+  miutil::replace(newTime, "%c", "%a %b %d %X GMT %Y");
+
+  std::vector<std::string> token, remove;
+
+  if (miutil::contains(newTime, "$")) {
+    token = miutil::split(newTime);
+
+    for (unsigned int i = 0; i < token.size(); i++) {
+      if (miutil::contains(token[i], "$")) {
+
+        std::string::size_type k;
+        if ((k = token[i].find("$tz=")) != std::string::npos) {
+          token[i] = token[i].substr(k + 4);
+          miutil::replace(newTime, "%tz", token[i]);
+          prepared.shifts.push_back(miTime().timezone(token[i]));
+          remove.push_back("$tz=" + token[i]);
+        }
+        if (miutil::contains(token[i], "$dst")) {
+          prepared.shifts.push_back(TIME_SHIFT_DST);
+          remove.push_back("$dst");
+        }
+        if (miutil::contains(token[i], "$time")) {
+          miutil::replace(newTime, token[i], YMD_HMS);
+        }
+        if (miutil::contains(token[i], "$date")) {
+          miutil::replace(newTime, token[i], YMD);
+        }
+        if (miutil::contains(token[i], "$clock")) {
+          miutil::replace(newTime, token[i], HMS);
+        }
+        if (miutil::contains(token[i], "$autoclock")) {
+          if (has_sec)
+            miutil::replace(newTime, token[i], HMS);
+          else if (has_min)
+            miutil::replace(newTime, token[i], "%H:%M");
+          else
+            miutil::replace(newTime, token[i], "%H");
+        }
+        if (miutil::contains(token[i], "$miniclock")) {
+          if (has_min)
+            miutil::replace(newTime, token[i], "%H:%M");
+          else
+            miutil::replace(newTime, token[i], "%H");
+        }
+        if ((k = token[i].find("$lg=")) != std::string::npos) {
+          token[i] = token[i].substr(k + 4);
+          if (miutil::contains(token[i], "nor"))
+            l = "no";
+          else if (miutil::contains(token[i], "eng"))
+            l = "en";
+          else if (miutil::contains(token[i], "swe"))
+            l = "se";
+          else
+            l = token[i];
+          remove.push_back("$lg=" + token[i]);
+        }
+
+        if (remove.size()) {
+          for (unsigned int n = 0; n < remove.size(); n++) {
+            std::string rm1 = " " + remove[n];
+            std::string rm2 = remove[n] + " ";
+            if (miutil::contains(newTime, rm1))
+              miutil::replace(newTime, rm1, "");
+            else if (miutil::contains(newTime, rm2))
+              miutil::replace(newTime, rm2, "");
+            else
+              miutil::replace(newTime, remove[n], "");
+          }
+          remove.clear();
+        }
+      }
+    }
+  }
+}
+
+void apply_time_shifts(miTime& t, const std::vector<int>& shifts)
+{
+  for (int s : shifts)
+    t.addHour(s == TIME_SHIFT_DST ? t.dst() : s);
+}
+
+} // namespace detail
+
+namespace {
+
+enum OpCode {
+  OP_LITERAL,
+  // date, as in miDate::format
+  OP_y, OP_Y, OP_d, OP_e, OP_m, OP_D, OP_B, OP_b, OP_A, OP_a, OP_V,
+  OP_lower_B, OP_lower_b, OP_lower_A, OP_lower_a,
+  // clock, as in miClock::format
+  OP_HMS, OP_r, OP_H, OP_I, OP_k, OP_l, OP_M, OP_p, OP_S, OP_30M,
+  OP_NONE
+};
+
+// same patterns as miDate::format, mapped to OpCode
+const Replacer& date_patterns()
+{
+  static const Replacer patterns({
+      "%y", "%Y", "%d", "%e", "%m", "%D", "%B", "%b", "%A", "%a", "%V", "%_B", "%_b", "%_A", "%_a"
+  });
+  return patterns;
+}
+
+const OpCode date_ops[] = {
+  OP_y, OP_Y, OP_d, OP_e, OP_m, OP_D, OP_B, OP_b, OP_A, OP_a, OP_V, OP_lower_B, OP_lower_b, OP_lower_A, OP_lower_a
+};
+
+// same patterns as miClock::format, mapped to OpCode
+const Replacer& clock_patterns()
+{
+  static const Replacer patterns({
+      "%X", "%T", "%r", "%H", "%I", "%k", "%l", "%M", "%p", "%S", "$30M",
+      " $midnight24", "$midnight24 ", "$midnight24"
+  });
+  return patterns;
+}
+
+const OpCode clock_ops[] = {
+  OP_HMS, OP_HMS, OP_r, OP_H, OP_I, OP_k, OP_l, OP_M, OP_p, OP_S, OP_30M,
+  OP_NONE, OP_NONE, OP_NONE
+};
+
+inline bool is_name(int op)
+{
+  return (op >= OP_B && op <= OP_a) || (op >= OP_lower_B && op <= OP_lower_a);
+}
+
+// writes to [p, last), p becomes nullptr when the buffer is too small
+struct Output {
+  char* p;
+  char* last;
+
+  void put(const char* s, std::size_t n)
+    {
+      if (p && std::size_t(last - p) >= n) {
+        std::memcpy(p, s, n);
+        p += n;
+      } else {
+        p = nullptr;
+      }
+    }
+  void put(std::string_view s)
+    { put(s.data(), s.size()); }
+  void number(int value, int width=0)
+    { if (p) p = format_number(p, last, value, width); }
+  void lower(std::string_view s, bool utf8)
+    {
+      char* begin = p;
+      put(s);
+      if (p) {
+        if (utf8)
+          to_lower_utf8_inplace(begin, p);
+        else
+          to_lower_latin1_inplace(begin, p);
+      }
+    }
+};
+
+} // namespace
+
+TimeFormatter::TimeFormatter(std::string_view format, std::string_view lang, bool utf8)
+  : format_(format)
+  , lang_(lang)
+  , utf8_(utf8)
+  , slow_(false)
+{
+  // the text of the format depends on the seconds and minutes being 0
+  // ($autoclock, $miniclock) and on the time being midnight ($midnight24)
+  std::vector<std::pair<std::string, bool>> compiled;
+  detail::TimeFormatPreparation prepared;
+  for (int variant=0; variant<4; ++variant) {
+    detail::prepare_time_format(format_, lang_, variant & 1, variant & 2, prepared);
+    if (variant == 0) {
+      prepared_lang_ = prepared.lang;
+      shifts_ = prepared.shifts;
+    }
+    const bool has_midnight24 = miutil::contains(prepared.format, "$midnight24");
+    for (int midnight=0; midnight<2; ++midnight) {
+      std::string text = prepared.format;
+      if (has_midnight24 && !midnight) {
+        miutil::replace(text, " $midnight24", "");
+        miutil::replace(text, "$midnight24 ", "");
+        miutil::replace(text, "$midnight24", "");
+      }
+      const std::pair<std::string, bool> key(text, has_midnight24 && midnight);
+      std::size_t index = std::find(compiled.begin(), compiled.end(), key) - compiled.begin();
+      if (index == compiled.size()) {
+        compiled.push_back(key);
+        programs_.emplace_back();
+        compile(key.first, key.second, programs_.back());
+      }
+      program_index_[variant][midnight] = index;
+    }
+  }
+}
+
+void TimeFormatter::compile(const std::string& format, bool midnight24, Program& program)
+{
+  program.midnight24 = midnight24;
+  program.names = false;
+
+  auto add_literal = [&](std::string_view literal) {
+    if (literal.empty())
+      return;
+    if (!program.ops.empty() && program.ops.back().code == OP_LITERAL
+        && program.ops.back().offset + program.ops.back().length == text_.size())
+    {
+      program.ops.back().length += literal.size();
+    } else {
+      program.ops.push_back(Op{ OP_LITERAL, std::uint32_t(text_.size()), std::uint32_t(literal.size()) });
+    }
+    text_ += literal;
+  };
+
+  // the clock patterns in the text between date patterns; returns the
+  // text after the last clock pattern
+  auto add_clock = [&](std::string_view text) {
+    std::size_t pos = 0;
+    int pattern;
+    for (std::size_t hit = clock_patterns().find(text, pos, pattern); hit != std::string_view::npos;
+         hit = clock_patterns().find(text, pos, pattern))
+    {
+      add_literal(text.substr(pos, hit - pos));
+      if (clock_ops[pattern] != OP_NONE)
+        program.ops.push_back(Op{ std::uint8_t(clock_ops[pattern]), 0, 0 });
+      pos = hit + clock_patterns().length(pattern);
+    }
+    add_literal(text.substr(pos));
+    return text.substr(pos);
+  };
+
+  const std::string_view text = format;
+  std::size_t pos = 0;
+  int pattern;
+  for (std::size_t hit = date_patterns().find(text, pos, pattern); hit != std::string_view::npos;
+       hit = date_patterns().find(text, pos, pattern))
+  {
+    const OpCode op = date_ops[pattern];
+    const std::string_view rest = add_clock(text.substr(pos, hit - pos));
+    // miClock::format scans the output of miDate::format, where a name
+    // after '%' or a number after '$' might form a new clock pattern
+    if (rest.find('$') != std::string_view::npos || (is_name(op) && !rest.empty() && rest.back() == '%'))
+      slow_ = true;
+    program.names |= is_name(op);
+    program.ops.push_back(Op{ std::uint8_t(op), 0, 0 });
+    pos = hit + date_patterns().length(pattern);
+  }
+  add_clock(text.substr(pos));
+}
+
+char* TimeFormatter::run(char* first, char* last, const Program& program, const miTime& t) const
+{
+  const miDate date = t.date();
+  const miClock clock = t.clock();
+  const int hour = clock.hour(), min = clock.min(), sec = clock.sec();
+  const bool pm = (hour < 1 || hour > 12);
+  const int tH = (hour ? hour : 24) - (pm ? 12 : 0);
+
+  miDate::Translations_cp translations;
+  if (program.names)
+    translations = miDate::language(prepared_lang_);
+  const int month = date.month() - 1, weekday = date.dayOfWeek();
+
+  Output out = { first, last };
+  for (const Op& op : program.ops) {
+    switch (op.code) {
+    case OP_LITERAL: out.put(text_.data() + op.offset, op.length); break;
+    case OP_y: out.number(date.year() % 100, 2); break;
+    case OP_Y: out.number(date.year(), 4); break;
+    case OP_d: out.number(date.day(), 2); break;
+    case OP_e: out.number(date.day()); break;
+    case OP_m: out.number(date.month(), 2); break;
+    case OP_D:
+      out.number(date.year(), 4);
+      out.put("-", 1);
+      out.number(date.month(), 2);
+      out.put("-", 1);
+      out.number(date.day(), 2);
+      break;
+    case OP_B: out.put(translations->monthname(month, utf8_)); break;
+    case OP_b: out.put(translations->shortmonthname(month, utf8_)); break;
+    case OP_A: out.put(translations->weekday(weekday, utf8_)); break;
+    case OP_a: out.put(translations->shortweekday(weekday, utf8_)); break;
+    case OP_V: out.number(date.weekNo()); break;
+    case OP_lower_B: out.lower(translations->monthname(month, utf8_), utf8_); break;
+    case OP_lower_b: out.lower(translations->shortmonthname(month, utf8_), utf8_); break;
+    case OP_lower_A: out.lower(translations->weekday(weekday, utf8_), utf8_); break;
+    case OP_lower_a: out.lower(translations->shortweekday(weekday, utf8_), utf8_); break;
+    case OP_HMS:
+    case OP_H:
+      if (program.midnight24)
+        out.put("24", 2);
+      else
+        out.number(hour, 2);
+      if (op.code == OP_HMS) {
+        out.put(":", 1);
+        out.number(min, 2);
+        out.put(":", 1);
+        out.number(sec, 2);
+      }
+      break;
+    case OP_r:
+      out.number(tH, 2);
+      out.put(":", 1);
+      out.number(min, 2);
+      out.put(":", 1);
+      out.number(sec, 2);
+      out.put(pm ? " PM" : " AM", 3);
+      break;
+    case OP_I: out.number(tH, 2); break;
+    case OP_k:
+      if (program.midnight24)
+        out.put("24", 2);
+      else
+        out.number(hour);
+      break;
+    case OP_l: out.number(tH); break;
+    case OP_M: out.number(min, 2); break;
+    case OP_p: out.put(pm ? "PM" : "AM", 2); break;
+    case OP_S: out.number(sec, 2); break;
+    case OP_30M: out.put(min < 30 ? "00" : "30", 2); break;
+    }
+  }
+  return out.p;
+}
+
+char* TimeFormatter::fallback(char* first, char* last, const miTime& t) const
+{
+  const std::string text = t.format(format_, lang_, utf8_);
+  Output out = { first, last };
+  out.put(text);
+  return out.p;
+}
+
+char* TimeFormatter::format(char* first, char* last, const miTime& t) const
+{
+  if (slow_ || t.undef())
+    return fallback(first, last, t);
+
+  miTime ftim(t);
+  detail::apply_time_shifts(ftim, shifts_);
+
+  const miClock clock = t.clock();
+  const miClock fclock = ftim.clock();
+  const int variant = (clock.sec() != 0) + 2*(clock.min() != 0);
+  const bool midnight = (fclock.hour() == 0 && fclock.min() == 0 && fclock.sec() == 0);
+  const Program& program = programs_[program_index_[variant][midnight]];
+  if (program.midnight24)
+    ftim.addDay(-1);
+  return run(first, last, program, ftim);
+}
+
+void TimeFormatter::append(std::string& out, const miTime& t) const
+{
+  char buffer[256];
+  if (const char* end = format(buffer, buffer + sizeof(buffer), t))
+    out.append(buffer, end - buffer);
+  else
+    out += t.format(format_, lang_, utf8_);
+}
+
+} // namespace miutil
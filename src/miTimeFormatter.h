@@ -0,0 +1,123 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+
+#ifndef PUTOOLS_MITIMEFORMATTER_H
+#define PUTOOLS_MITIMEFORMATTER_H
+
+#include "miTime.h"
+
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miutil {
+
+namespace detail {
+enum { TIME_SHIFT_DST = INT_MIN };
+
+/// result of handling the '$' directives of a miTime format
+struct TimeFormatPreparation {
+  std::string format;       //!< format with '$' directives replaced or removed, except $midnight24
+  std::string lang;         //!< language after $lg=
+  std::vector<int> shifts;  //!< hours to add from $tz=, or TIME_SHIFT_DST for $dst, in order
+};
+
+/**
+ * Handle "%c" and the '$' directives of miTime::format. The text only
+ * depends on whether seconds and minutes of the time are non-zero.
+ */
+void prepare_time_format(const std::string& format, const std::string& lang,
+    bool has_sec, bool has_min, TimeFormatPreparation& prepared);
+
+/// add the shifts of a TimeFormatPreparation to t
+void apply_time_shifts(miTime& t, const std::vector<int>& shifts);
+} // namespace detail
+
+/**
+ * A miTime format compiled once for formatting many times.
+ *
+ * The output is the same as miTime::format(format, lang, utf8). The
+ * format is parsed into a list of instructions when the formatter is
+ * constructed, and formatting into a caller's buffer does not
+ * allocate. Month and day names are looked up when formatting, so
+ * miTime::setDefaultLanguage is respected as in miTime::format.
+ *
+ * A few formats where a name could form a new pattern with the
+ * characters before it, e.g. "%%B", and undefined times are handed
+ * to miTime::format.
+ */
+class TimeFormatter {
+public:
+  explicit TimeFormatter(std::string_view format, std::string_view lang="", bool utf8=false);
+
+  /**
+   * Write the formatted time to [first, last).
+   * \return the end of the written text, or nullptr if the buffer is too small
+   */
+  char* format(char* first, char* last, const miTime& t) const;
+
+  /// append the formatted time to out
+  void append(std::string& out, const miTime& t) const;
+
+  std::string format(const miTime& t) const
+    { std::string out; append(out, t); return out; }
+
+private:
+  struct Op {
+    std::uint8_t code;
+    std::uint32_t offset; //!< for literals, the position in text_
+    std::uint32_t length;
+  };
+
+  struct Program {
+    std::vector<Op> ops;
+    bool midnight24;  //!< the format contains $midnight24 and the time is midnight
+    bool names;       //!< uses month or day names
+  };
+
+  void compile(const std::string& format, bool midnight24, Program& program);
+  char* run(char* first, char* last, const Program& program, const miTime& t) const;
+  char* fallback(char* first, char* last, const miTime& t) const;
+
+  std::string format_;
+  std::string lang_;
+  bool utf8_;
+  bool slow_;
+  std::string prepared_lang_;
+  std::vector<int> shifts_;
+  std::string text_;
+  std::vector<Program> programs_;
+  int program_index_[4][2]; //!< [has_sec + 2*has_min][midnight]
+};
+
+} // namespace miutil
+
+#endif // PUTOOLS_MITIMEFORMATTER_H
@@ -0,0 +1,358 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miUtf8.h"
+
+#include "miCharSet.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define PUTOOLS_UTF8_X86 1
+#include <immintrin.h>
+#endif
+
+namespace miutil {
+
+namespace {
+
+const std::uint64_t HIGH_BITS = 0x8080808080808080ull;
+
+/*
+ * The ascii_run functions return the number of leading ASCII bytes in
+ * [in, in+n). If out is not null, these bytes are also copied to out.
+ */
+typedef std::size_t (*ascii_run_f)(const char* in, std::size_t n, char* out);
+
+/// number of bytes >= 0x80 in [in, in+n)
+typedef std::size_t (*count_non_ascii_f)(const char* in, std::size_t n);
+
+std::size_t ascii_tail(const char* in, std::size_t i, std::size_t n, char* out)
+{
+  for (; i < n && static_cast<unsigned char>(in[i]) < 0x80; ++i) {
+    if (out)
+      out[i] = in[i];
+  }
+  return i;
+}
+
+std::size_t ascii_run_scalar(const char* in, std::size_t n, char* out)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, in + i, 8);
+    if (w & HIGH_BITS)
+      break;
+    if (out)
+      std::memcpy(out + i, &w, 8);
+  }
+  return ascii_tail(in, i, n, out);
+}
+
+std::size_t count_non_ascii_scalar(const char* in, std::size_t n)
+{
+  std::size_t count = 0, i = 0;
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, in + i, 8);
+    count += __builtin_popcountll(w & HIGH_BITS);
+  }
+  for (; i < n; ++i)
+    count += (static_cast<unsigned char>(in[i]) >> 7);
+  return count;
+}
+
+#ifdef PUTOOLS_UTF8_X86
+std::size_t ascii_run_sse2(const char* in, std::size_t n, char* out)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    if (_mm_movemask_epi8(v))
+      break;
+    if (out)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+  }
+  return ascii_tail(in, i, n, out);
+}
+
+std::size_t count_non_ascii_sse2(const char* in, std::size_t n)
+{
+  std::size_t count = 0, i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    count += __builtin_popcount(_mm_movemask_epi8(v));
+  }
+  return count + count_non_ascii_scalar(in + i, n - i);
+}
+
+__attribute__((target("avx2")))
+std::size_t ascii_run_avx2(const char* in, std::size_t n, char* out)
+{
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    if (_mm256_movemask_epi8(v))
+      break;
+    if (out)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+  }
+  return ascii_tail(in, i, n, out);
+}
+
+__attribute__((target("avx2,popcnt")))
+std::size_t count_non_ascii_avx2(const char* in, std::size_t n)
+{
+  std::size_t count = 0, i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    count += __builtin_popcount(_mm256_movemask_epi8(v));
+  }
+  return count + count_non_ascii_scalar(in + i, n - i);
+}
+#endif // PUTOOLS_UTF8_X86
+
+ascii_run_f select_ascii_run()
+{
+#ifdef PUTOOLS_UTF8_X86
+  switch (CharSet::engine()) {
+  case CharSet::ENGINE_AVX2: return ascii_run_avx2;
+  case CharSet::ENGINE_SSE2: return ascii_run_sse2;
+  default: break;
+  }
+#endif
+  return ascii_run_scalar;
+}
+
+count_non_ascii_f select_count_non_ascii()
+{
+#ifdef PUTOOLS_UTF8_X86
+  switch (CharSet::engine()) {
+  case CharSet::ENGINE_AVX2: return count_non_ascii_avx2;
+  case CharSet::ENGINE_SSE2: return count_non_ascii_sse2;
+  default: break;
+  }
+#endif
+  return count_non_ascii_scalar;
+}
+
+} // namespace
+
+std::size_t ascii_prefix(std::string_view text)
+{
+  return select_ascii_run()(text.data(), text.size(), nullptr);
+}
+
+std::size_t utf8_size_of_latin1(std::string_view latin1)
+{
+  return latin1.size() + select_count_non_ascii()(latin1.data(), latin1.size());
+}
+
+char* latin1_to_utf8(std::string_view latin1, char* out)
+{
+  const ascii_run_f ascii_run = select_ascii_run();
+  const char* in = latin1.data();
+  const char* const end = in + latin1.size();
+  while (in < end) {
+    const std::size_t n = ascii_run(in, end - in, out);
+    in += n;
+    out += n;
+    for (; in < end && static_cast<unsigned char>(*in) >= 0x80; ++in) {
+      const unsigned char u = *in;
+      *out++ = static_cast<char>(0xC0 | (u >> 6));
+      *out++ = static_cast<char>(0x80 | (u & 0x3F));
+    }
+  }
+  return out;
+}
+
+int decode_utf8(const char* p, std::size_t n, std::uint32_t& code_point)
+{
+  const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+  const unsigned char c = u[0];
+  if (c < 0x80) {
+    code_point = c;
+    return 1;
+  }
+
+  // reject overlong encodings, surrogates and code points above U+10FFFF
+  // by limiting the range of the second byte
+  int length;
+  unsigned char min_second = 0x80, max_second = 0xBF;
+  if (c >= 0xC2 && c <= 0xDF) {
+    length = 2;
+    code_point = c & 0x1F;
+  } else if (c >= 0xE0 && c <= 0xEF) {
+    length = 3;
+    code_point = c & 0x0F;
+    if (c == 0xE0)
+      min_second = 0xA0;
+    else if (c == 0xED)
+      max_second = 0x9F;
+  } else if (c >= 0xF0 && c <= 0xF4) {
+    length = 4;
+    code_point = c & 0x07;
+    if (c == 0xF0)
+      min_second = 0x90;
+    else if (c == 0xF4)
+      max_second = 0x8F;
+  } else {
+    return -1;
+  }
+
+  for (int i=1; i<length; ++i) {
+    if (std::size_t(i) >= n)
+      return 0;
+    const unsigned char b = u[i];
+    if (i == 1 ? (b < min_second || b > max_second) : ((b & 0xC0) != 0x80))
+      return -1;
+    code_point = (code_point << 6) | (b & 0x3F);
+  }
+  return length;
+}
+
+std::size_t find_invalid_utf8(std::string_view utf8)
+{
+  const ascii_run_f ascii_run = select_ascii_run();
+  const char* p = utf8.data();
+  const std::size_t n = utf8.size();
+  std::size_t pos = 0;
+  while (true) {
+    pos += ascii_run(p + pos, n - pos, nullptr);
+    if (pos >= n)
+      return std::string_view::npos;
+    std::uint32_t code_point;
+    const int length = decode_utf8(p + pos, n - pos, code_point);
+    if (length <= 0)
+      return pos;
+    pos += length;
+  }
+}
+
+// ------------------------------------------------------------------------
+
+void Latin1ToUtf8Converter::convert(std::string_view chunk, std::string& out)
+{
+  const std::size_t size = out.size();
+  out.resize(size + utf8_size_of_latin1(chunk));
+  latin1_to_utf8(chunk, &out[size]);
+}
+
+// ------------------------------------------------------------------------
+
+void Utf8ToLatin1Converter::convert(std::string_view chunk, std::string& out)
+{
+  // each input byte gives at most one output byte
+  const std::size_t size = out.size();
+  out.resize(size + npending_ + chunk.size());
+  char* const begin = &out[0];
+  char* o = begin + size;
+
+  const ascii_run_f ascii_run = select_ascii_run();
+  const char* p = chunk.data();
+  const std::size_t n = chunk.size();
+  std::size_t pos = complete_pending(chunk, o);
+  while (pos < n) {
+    const std::size_t ascii = ascii_run(p + pos, n - pos, o);
+    pos += ascii;
+    o += ascii;
+    if (pos >= n)
+      break;
+
+    std::uint32_t code_point;
+    const int length = decode_utf8(p + pos, n - pos, code_point);
+    if (length > 0) {
+      put(code_point, o);
+      pos += length;
+    } else if (length == 0) {
+      // incomplete, keep for the next chunk
+      npending_ = n - pos;
+      std::memcpy(pending_, p + pos, npending_);
+      break;
+    } else {
+      *o++ = replacement_;
+      errors_ += 1;
+      pos += 1;
+    }
+  }
+  out.resize(o - begin);
+}
+
+bool Utf8ToLatin1Converter::finish(std::string& out)
+{
+  out.append(npending_, replacement_);
+  errors_ += npending_;
+  npending_ = 0;
+  return errors_ == 0;
+}
+
+void Utf8ToLatin1Converter::put(std::uint32_t code_point, char*& out)
+{
+  if (code_point <= 0xFF) {
+    *out++ = static_cast<char>(code_point);
+  } else {
+    *out++ = replacement_;
+    errors_ += 1;
+  }
+}
+
+std::size_t Utf8ToLatin1Converter::complete_pending(std::string_view chunk, char*& out)
+{
+  if (npending_ == 0)
+    return 0;
+
+  char buffer[4];
+  std::memcpy(buffer, pending_, npending_);
+  const std::size_t take = std::min<std::size_t>(4 - npending_, chunk.size());
+  std::memcpy(buffer + npending_, chunk.data(), take);
+  const std::size_t have = npending_ + take;
+
+  std::uint32_t code_point;
+  const int length = decode_utf8(buffer, have, code_point);
+  if (length == 0) {
+    // still incomplete, the chunk was too short
+    std::memcpy(pending_, buffer, have);
+    npending_ = have;
+    return chunk.size();
+  }
+  if (length < 0) {
+    // replace the first pending byte, and try again with the rest
+    *out++ = replacement_;
+    errors_ += 1;
+    npending_ -= 1;
+    std::memmove(pending_, pending_ + 1, npending_);
+    return complete_pending(chunk, out);
+  }
+  put(code_point, out);
+  const std::size_t used = length - npending_;
+  npending_ = 0;
+  return used;
+}
+
+} // namespace miutil
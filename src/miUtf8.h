@@ -0,0 +1,121 @@
+/* -*- c++ -*-
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PUTOOLS_MIUTF8_H
+#define PUTOOLS_MIUTF8_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace miutil {
+
+/**
+ * Conversion between ISO 8859-1 (latin1) and UTF-8.
+ *
+ * Runs of ASCII characters are copied in blocks of 16 or 32 bytes
+ * (SSE2 or AVX2, following CharSet::engine()); only the other
+ * characters are converted one at a time.
+ */
+
+/// number of leading ASCII characters in text
+std::size_t ascii_prefix(std::string_view text);
+
+/// exact size of the UTF-8 encoding of a latin1 text
+std::size_t utf8_size_of_latin1(std::string_view latin1);
+
+/**
+ * Write the UTF-8 encoding of latin1 to out, which must have room for
+ * utf8_size_of_latin1(latin1) bytes.
+ * \return the end of the written text
+ */
+char* latin1_to_utf8(std::string_view latin1, char* out);
+
+/// position of the first byte that is not part of a valid UTF-8 sequence, or npos
+std::size_t find_invalid_utf8(std::string_view utf8);
+
+inline bool is_valid_utf8(std::string_view utf8)
+  { return find_invalid_utf8(utf8) == std::string_view::npos; }
+
+/**
+ * Decode one UTF-8 sequence from [p, p+n), n > 0.
+ * \return the length of the sequence, 0 if it is valid but incomplete, or -1 if it is invalid
+ */
+int decode_utf8(const char* p, std::size_t n, std::uint32_t& code_point);
+
+/**
+ * Streaming conversion from latin1 to UTF-8, with the same interface as
+ * Utf8ToLatin1Converter.
+ */
+class Latin1ToUtf8Converter {
+public:
+  /// append the conversion of chunk to out
+  void convert(std::string_view chunk, std::string& out);
+
+  /// always true, every latin1 text can be converted
+  bool finish(std::string&)
+    { return true; }
+};
+
+/**
+ * Streaming conversion from UTF-8 to latin1.
+ *
+ * A sequence split between two chunks is kept until the next call to
+ * convert. Each invalid byte, and each character outside latin1, is
+ * replaced by the replacement character and counted as an error.
+ */
+class Utf8ToLatin1Converter {
+public:
+  explicit Utf8ToLatin1Converter(char replacement='?')
+    : replacement_(replacement), npending_(0), errors_(0) {}
+
+  /// append the conversion of chunk to out
+  void convert(std::string_view chunk, std::string& out);
+
+  /**
+   * Replace the bytes of an incomplete sequence at the end of the input.
+   * \return true if there were no errors
+   */
+  bool finish(std::string& out);
+
+  std::size_t errors() const
+    { return errors_; }
+
+private:
+  void put(std::uint32_t code_point, char*& out);
+  std::size_t complete_pending(std::string_view chunk, char*& out);
+
+private:
+  char replacement_;
+  char pending_[4];
+  int npending_;
+  std::size_t errors_;
+};
+
+} // namespace miutil
+
+#endif // PUTOOLS_MIUTF8_H
@@ -1,9 +1,9 @@
 #ifndef METLIBS_PUTOOLS_VERSION_H
 #define METLIBS_PUTOOLS_VERSION_H
 
-#define METLIBS_PUTOOLS_VERSION_MAJOR 8
-#define METLIBS_PUTOOLS_VERSION_MINOR 1
-#define METLIBS_PUTOOLS_VERSION_PATCH 2
+#define METLIBS_PUTOOLS_VERSION_MAJOR 9
+#define METLIBS_PUTOOLS_VERSION_MINOR 0
+#define METLIBS_PUTOOLS_VERSION_PATCH 0
 
 #define METLIBS_PUTOOLS_VERSION_INT(major,minor,patch) \
     (1000000*major + 1000*minor + patch)
@@ -0,0 +1,748 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Simple timing of string functions, not part of the test suite.
+//
+// Usage: putools_bench [benchmark-name...]
+
+#include "miCharSet.h"
+#include "miCharTransform.h"
+#include "miDate.h"
+#include "miFixedString.h"
+#include "miFixedWidth.h"
+#include "miLineChunks.h"
+#include "miLineReader.h"
+#include "miNumberParse.h"
+#include "miStringBuilder.h"
+#include "miStringCompare.h"
+#include "miStringJoin.h"
+#include "miStringPool.h"
+#include "miStringSplit.h"
+#include "miTime.h"
+#include "miTimeFormatter.h"
+#include "miUtf8.h"
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+volatile size_t sink; // prevents the compiler from dropping results
+
+template<class F>
+void run(const std::string& label, size_t bytes_per_call, F f)
+{
+  typedef std::chrono::steady_clock clock_type;
+  size_t calls = 0;
+  const clock_type::time_point start = clock_type::now();
+  clock_type::duration elapsed;
+  do {
+    for (int i=0; i<16; ++i)
+      sink = f();
+    calls += 16;
+    elapsed = clock_type::now() - start;
+  } while (elapsed < std::chrono::milliseconds(500));
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  std::cout << std::setw(40) << std::left << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(1)
+            << (1e9 * seconds / calls) << " ns/call"
+            << std::setw(10) << (bytes_per_call * calls / seconds / (1 << 20)) << " MiB/s"
+            << std::endl;
+}
+
+// ########################################################################
+
+std::string make_record(size_t fields, const char* separator, int seed=17)
+{
+  std::mt19937 rng(seed);
+  std::string record;
+  for (size_t i=0; i<fields; ++i) {
+    if (i > 0) {
+      record += separator;
+      if (rng() % 4 == 0)
+        record += separator;
+    }
+    if (rng() % 3 == 0)
+      record += '-';
+    record += std::to_string(rng() % 100000);
+    record += '.';
+    record += std::to_string(rng() % 100);
+  }
+  return record;
+}
+
+// the implementation of miutil::split before string_view tokenizers were added
+std::vector<std::string> split_find_first_of(const std::string& text, const char* separator_chars)
+{
+  std::vector<std::string> vec;
+  size_t len = text.length();
+  size_t start = text.find_first_not_of(separator_chars, 0);
+  while (start != std::string::npos && start<len) {
+    size_t stop = text.find_first_of(separator_chars, start);
+    if (stop == std::string::npos || stop > len)
+      stop=len;
+    vec.push_back(text.substr(start, stop-start));
+    start = text.find_first_not_of(separator_chars, stop+1);
+  }
+  return vec;
+}
+
+// the implementation of miutil::split_protected before ProtectedSplitViews was added
+std::vector<std::string> split_protected_find(const std::string& text, const char lb, const char rb,
+                                              const char* separator_chars)
+{
+  std::vector<std::string> vec;
+  const size_t len = text.length();
+  size_t start = text.find_first_not_of(separator_chars, 0);
+  while (start != std::string::npos && start<len) {
+    size_t stop = text.find_first_of(separator_chars, start);
+    size_t tmp = start;
+    bool isok = false;
+    while (not isok) {
+      const size_t lbp = text.find(lb, tmp);
+      if (lbp != std::string::npos && lbp < stop) {
+        const size_t rbp = text.find(rb, lbp+1);
+        if (rbp == std::string::npos)
+          return vec;
+        tmp = rbp+1;
+        if (rbp > stop)
+          stop = text.find_first_of(separator_chars, tmp);
+      } else {
+        isok = true;
+      }
+    }
+    if (stop == std::string::npos || stop>len)
+      stop=len;
+    vec.push_back(text.substr(start, stop-start));
+    start = text.find_first_not_of(separator_chars, stop+1);
+  }
+  return vec;
+}
+
+// the implementation of miutil::to_double before from_chars was used
+double to_double_istringstream(const std::string& text, const double undefined=NAN)
+{
+  double ret = undefined;
+  char test = 0;
+  std::istringstream iss(text);
+  iss.imbue(std::locale::classic());
+  iss >> ret >> test;
+  if (not iss.eof())
+    return undefined;
+  return ret;
+}
+
+// the implementation of miutil::remove before miCharTransform was added
+void remove_find_erase(std::string& text, const char c)
+{
+  for (size_t pos=text.find(c); pos!=std::string::npos; pos=text.find(c))
+    text.erase(pos,1);
+}
+
+// the implementation of miutil::to_lower_latin1 before miCharTransform was added
+std::string to_lower_latin1_tolower(const std::string& text)
+{
+  std::string t(text);
+  for (size_t i=0; i<t.size(); ++i) {
+    unsigned char c = tolower(t[i]);
+    if ((c>=192 && c<=214) || (c>=216 && c<=222))
+      c+=32;
+    t[i] = c;
+  }
+  return t;
+}
+
+// the implementation of miutil::from_latin1_to_utf8 before miUtf8 was added
+std::string latin1_to_utf8_bytewise(const std::string& latin1)
+{
+  std::string utf8;
+  utf8.reserve(latin1.size());
+  for (char ch : latin1) {
+    unsigned char uch = static_cast<unsigned char>(ch);
+    if ((uch & 0x80) != 0) {
+      utf8 += static_cast<char>(0xc0 | (uch >> 6));
+      uch = (0x80 | (uch & 0x3f));
+    }
+    utf8 += static_cast<char>(uch);
+  }
+  return utf8;
+}
+
+// the implementation of miutil::miDate::format before miutil::Replacer was used
+std::string format_date_replace(const miutil::miDate& date, const std::string& newDate, const std::string& l)
+{
+  std::string d(newDate);
+  miutil::replace(d, "%y", miutil::from_number(date.year()%100, 2));
+  miutil::replace(d, "%Y", miutil::from_number(date.year(), 4));
+  miutil::replace(d, "%d", miutil::from_number(date.day(),2));
+  miutil::replace(d, "%e", miutil::from_number(date.day()));
+  miutil::replace(d, "%m", miutil::from_number(date.month(),2));
+  miutil::replace(d, "%D", date.isoDate());
+  miutil::replace(d, "%B", date.monthname(l, false));
+  miutil::replace(d, "%b", date.shortmonthname(l, false));
+  miutil::replace(d, "%A", date.weekday(l, false));
+  miutil::replace(d, "%a", date.shortweekday(l, false));
+  miutil::replace(d, "%V", miutil::from_number(date.weekNo()));
+  miutil::replace(d, "%_B", miutil::to_lower(date.monthname(l, false)));
+  miutil::replace(d, "%_b", miutil::to_lower(date.shortmonthname(l, false)));
+  miutil::replace(d, "%_A", miutil::to_lower(date.weekday(l, false)));
+  miutil::replace(d, "%_a", miutil::to_lower(date.shortweekday(l, false)));
+  return d;
+}
+
+const char* engine_name(miutil::CharSet::Engine e)
+{
+  switch (e) {
+  case miutil::CharSet::ENGINE_SCALAR: return "scalar";
+  case miutil::CharSet::ENGINE_SSE2: return "sse2";
+  case miutil::CharSet::ENGINE_AVX2: return "avx2";
+  default: return "auto";
+  }
+}
+
+void bench_split()
+{
+  for (size_t fields : { 10, 200, 2000 }) {
+    const std::string record = make_record(fields, " \t");
+    std::cout << "-- " << fields << " fields, " << record.size() << " bytes" << std::endl;
+
+    run("find_first_of split", record.size(),
+        [&]() { return split_find_first_of(record, miutil::whitespaces).size(); });
+
+    for (auto e : { miutil::CharSet::ENGINE_SCALAR, miutil::CharSet::ENGINE_SSE2, miutil::CharSet::ENGINE_AVX2 }) {
+      if (!miutil::CharSet::selectEngine(e))
+        continue;
+      const std::string name = engine_name(e);
+      run("miutil::split " + name, record.size(),
+          [&]() { return miutil::split(record).size(); });
+      run("miutil::split_views " + name, record.size(),
+          [&]() { size_t n = 0; for (std::string_view t : miutil::split_views(record)) n += t.size(); return n; });
+    }
+    miutil::TokenBuffer buffer;
+    run("miutil::split_into", record.size(),
+        [&]() { return miutil::split_into(buffer, record); });
+    miutil::CharSet::selectEngine(miutil::CharSet::ENGINE_AUTO);
+  }
+}
+
+void bench_find_first_of()
+{
+  std::string text(4096, 'x');
+  text += ' ';
+  run("std::string::find_first_of", text.size(),
+      [&]() { return text.find_first_of(miutil::whitespaces); });
+  for (auto e : { miutil::CharSet::ENGINE_SCALAR, miutil::CharSet::ENGINE_SSE2, miutil::CharSet::ENGINE_AVX2 }) {
+    if (!miutil::CharSet::selectEngine(e))
+      continue;
+    const miutil::CharSet ws(miutil::whitespaces);
+    run(std::string("CharSet::find_first_in ") + engine_name(e), text.size(),
+        [&]() { return ws.find_first_in(text); });
+  }
+  miutil::CharSet::selectEngine(miutil::CharSet::ENGINE_AUTO);
+}
+
+void bench_protected()
+{
+  for (size_t fields : { 10, 200, 2000 }) {
+    const std::string record = make_record(fields, " ") + " \"quoted text\"";
+    std::cout << "-- " << fields << " fields, " << record.size() << " bytes" << std::endl;
+
+    run("find split_protected", record.size(),
+        [&]() { return split_protected_find(record, '"', '"', miutil::whitespaces).size(); });
+    run("miutil::split_protected", record.size(),
+        [&]() { return miutil::split_protected(record, '"', '"').size(); });
+
+    miutil::SplitProtection protection;
+    protection.add('"', '"').add('(', ')').add('[', ']').nested();
+    run("miutil::split_protected 3 pairs", record.size(),
+        [&]() { return miutil::split_protected(record, protection).size(); });
+  }
+}
+
+void bench_lines()
+{
+  const std::string path = "/tmp/putools-bench-lines.txt";
+  size_t bytes = 0;
+  {
+    std::ofstream out(path, std::ios::binary);
+    for (int i=0; i<20000; ++i) {
+      const std::string record = make_record(20, " ", i);
+      out << record << '\n';
+      bytes += record.size() + 1;
+    }
+  }
+  std::cout << "-- 20000 lines, " << bytes << " bytes" << std::endl;
+
+  run("getline + split", bytes,
+      [&]() {
+        std::ifstream in(path);
+        size_t n = 0;
+        for (std::string line; std::getline(in, line); )
+          n += miutil::split(line).size();
+        return n;
+      });
+  for (auto mode : { miutil::LineReader::MODE_AUTO, miutil::LineReader::MODE_READ }) {
+    run(mode == miutil::LineReader::MODE_AUTO ? "LineReader mmap + split_views" : "LineReader read + split_views", bytes,
+        [&]() {
+          miutil::LineReader reader(path, mode);
+          size_t n = 0;
+          for (std::string_view line : reader)
+            for (std::string_view t : miutil::split_views(line))
+              n += t.size();
+          return n;
+        });
+  }
+  std::remove(path.c_str());
+}
+
+struct Observation {
+  miutil::miTime time;
+  double values[5];
+};
+
+void parse_observation(std::string_view line, std::vector<Observation>& out)
+{
+  miutil::SplitViews tokens(line, 0);
+  std::string_view token;
+  if (!tokens.next(token))
+    return;
+  Observation obs;
+  obs.time.setTime(std::string(token));
+  for (double& v : obs.values)
+    v = tokens.next(token) ? miutil::to_double(token.data(), token.size(), NAN) : NAN;
+  out.push_back(obs);
+}
+
+void bench_ingest()
+{
+  std::string text;
+  std::mt19937 rng(5);
+  for (int i=0; i<100000; ++i) {
+    const miutil::miTime t(2026, 1 + i % 12, 1 + i % 28, i % 24, i % 60, 0);
+    text += t.isoTime("T");
+    for (int v=0; v<5; ++v)
+      text += ' ' + std::to_string(rng() % 1000) + '.' + std::to_string(rng() % 10);
+    text += '\n';
+  }
+  std::cout << "-- 100000 observations, " << text.size() << " bytes, "
+            << miutil::default_thread_count() << " hardware threads" << std::endl;
+
+  std::vector<unsigned> threads = { 1 };
+  for (unsigned n=2; n<=miutil::default_thread_count(); n *= 2)
+    threads.push_back(n);
+  if (threads.back() != miutil::default_thread_count())
+    threads.push_back(miutil::default_thread_count());
+  for (unsigned n : threads) {
+    run("parallel_parse_lines " + std::to_string(n) + " threads", text.size(),
+        [&]() { return miutil::parallel_parse_lines<Observation>(text, parse_observation, n).size(); });
+  }
+}
+
+void bench_fixed()
+{
+  std::vector<std::string> records;
+  std::mt19937 rng(7);
+  for (int i=0; i<1000; ++i) {
+    char record[64];
+    std::snprintf(record, sizeof(record), "%05u %-11s %6.2f %6.2f %4u",
+        unsigned(rng() % 100000), "STATION", (rng() % 18000) / 100.0 - 90, (rng() % 36000) / 100.0 - 180,
+        unsigned(rng() % 3000));
+    records.push_back(record);
+  }
+  const size_t bytes = records.size() * records.front().size();
+  std::cout << "-- " << records.size() << " records of " << records.front().size() << " bytes" << std::endl;
+
+  std::vector<int> ids, heights;
+  std::vector<double> lats, lons;
+  std::vector<std::string> names;
+  run("substr + trim + to_int", bytes,
+      [&]() {
+        ids.clear(); heights.clear(); lats.clear(); lons.clear(); names.clear();
+        for (const std::string& r : records) {
+          ids.push_back(miutil::to_int(r.substr(0, 5)));
+          names.push_back(miutil::trimmed(r.substr(6, 11)));
+          lats.push_back(miutil::to_double(miutil::trimmed(r.substr(18, 6))));
+          lons.push_back(miutil::to_double(miutil::trimmed(r.substr(25, 6))));
+          heights.push_back(miutil::to_int(miutil::trimmed(r.substr(32, 4))));
+        }
+        return ids.size();
+      });
+
+  miutil::FixedWidthLayout layout;
+  layout.add("id", 0, 5, miutil::FixedWidthLayout::DIGITS);
+  layout.add("name", 6, 11, miutil::FixedWidthLayout::TEXT);
+  layout.add("lat", 18, 6, miutil::FixedWidthLayout::DOUBLE);
+  layout.add("lon", 25, 6, miutil::FixedWidthLayout::DOUBLE);
+  layout.add("height", 32, 4, miutil::FixedWidthLayout::INT);
+  miutil::FixedWidthColumns columns(layout);
+  run("FixedWidthColumns", bytes,
+      [&]() {
+        columns.clear();
+        for (const std::string& r : records)
+          columns.add(r);
+        return columns.size();
+      });
+}
+
+void bench_columns()
+{
+  const size_t fields = 200;
+  const std::string record = make_record(fields, ",");
+  std::cout << "-- " << fields << " columns, " << record.size() << " bytes" << std::endl;
+
+  std::vector<double> values(fields);
+  run("split + istringstream", record.size(),
+      [&]() {
+        const std::vector<std::string> tokens = miutil::split(record, ",");
+        for (size_t i=0; i<tokens.size() && i<fields; ++i)
+          values[i] = to_double_istringstream(tokens[i]);
+        return tokens.size();
+      });
+  run("split + to_double", record.size(),
+      [&]() {
+        const std::vector<std::string> tokens = miutil::split(record, ",");
+        for (size_t i=0; i<tokens.size() && i<fields; ++i)
+          values[i] = miutil::to_double(tokens[i]);
+        return tokens.size();
+      });
+  run("parse_columns", record.size(),
+      [&]() { return miutil::parse_columns(record, ",", true, values.data(), values.size()); });
+}
+
+struct Benchmark {
+  const char* name;
+  void (*function)();
+};
+
+// the implementation of miString::join before miutil::join was added
+template<class C>
+std::string join_ostringstream(const C& j, const std::string& delimiter)
+{
+  bool first=true;
+  std::ostringstream ost;
+  for (const auto& t : j) {
+    ost << (first ? "" : delimiter ) << t;
+    first = false;
+  }
+  return ost.str();
+}
+
+void bench_join()
+{
+  const std::vector<std::string> words = miutil::split(make_record(2000, " "));
+  std::vector<double> numbers;
+  for (const std::string& w : words)
+    numbers.push_back(miutil::to_double(w));
+  const size_t bytes = miutil::join(words, ",").size();
+  std::cout << "-- " << words.size() << " strings and numbers" << std::endl;
+
+  run("ostringstream strings", bytes,
+      [&]() { return join_ostringstream(words, ",").size(); });
+  run("miutil::join strings", bytes,
+      [&]() { return miutil::join(words, ",").size(); });
+  run("ostringstream numbers", bytes,
+      [&]() { return join_ostringstream(numbers, ",").size(); });
+  run("miutil::join_numbers", bytes,
+      [&]() { return miutil::join_numbers(numbers, ",").size(); });
+}
+
+void bench_icompare()
+{
+  const std::string a = make_record(20, " ");
+  const std::string b = miutil::to_upper(a) + "x";
+  std::cout << "-- " << a.size() << " bytes" << std::endl;
+
+  run("to_lower + compare", a.size(),
+      [&]() { return miutil::to_lower(a).compare(miutil::to_lower(b)) < 0; });
+  run("icompare", a.size(),
+      [&]() { return miutil::icompare(a, b) < 0; });
+  run("ihash", a.size(),
+      [&]() { return miutil::ihash(a); });
+
+  const miutil::miDate date(2026, 10, 17);
+  run("miDate::monthname(\"NO\")", 0,
+      [&]() { return date.monthname("NO").size(); });
+}
+
+void bench_intern()
+{
+  // observation records: station id, parameter, unit and value, with few distinct ids
+  std::mt19937 rng(5);
+  const char* parameters[] = { "TA", "RR_1", "FF", "DD", "PO", "UU" };
+  const char* units[] = { "degC", "mm", "m/s", "deg", "hPa", "percent" };
+  std::string text;
+  for (int i=0; i<1000; ++i) {
+    const int p = rng() % 6;
+    text += "station-" + std::to_string(1000 + rng() % 300) + ' ' + parameters[p] + ' ' + units[p] + ' '
+        + std::to_string(rng() % 1000) + '\n';
+  }
+  std::cout << "-- 1000 records, " << text.size() << " bytes" << std::endl;
+
+  std::unordered_map<std::string, int> string_counts;
+  run("split + map<std::string>", text.size(),
+      [&]() {
+        std::vector<std::vector<std::string>> records;
+        std::string_view rest = text;
+        for (std::string_view line; miutil::next_line(rest, line); ) {
+          records.push_back(miutil::split(std::string(line)));
+          string_counts[records.back()[0]] += (records.back()[1] == "TA");
+        }
+        return records.size();
+      });
+  miutil::StringPool pool;
+  const miutil::PooledString ta = pool.intern("TA");
+  miutil::TokenBuffer tokens;
+  std::unordered_map<miutil::PooledString, int> pooled_counts;
+  run("split_into + StringPool", text.size(),
+      [&]() {
+        std::vector<std::vector<miutil::PooledString>> records;
+        std::string_view rest = text;
+        for (std::string_view line; miutil::next_line(rest, line); ) {
+          miutil::split_into(tokens, line);
+          records.push_back(pool.intern(tokens));
+          pooled_counts[records.back()[0]] += (records.back()[1] == ta);
+        }
+        return records.size();
+      });
+  std::cout << "   " << 4*sizeof(std::string) << " vs " << 4*sizeof(miutil::PooledString) << " bytes per record,"
+            << " pool: " << pool.size() << " strings in " << pool.memory() << " bytes" << std::endl;
+}
+
+void bench_fixed_string()
+{
+  struct StringRecord { std::string station; double value; };
+  struct FixedRecord { miutil::FixedString<5> station; double value; };
+  std::mt19937 rng(11);
+  std::vector<StringRecord> string_records;
+  std::vector<FixedRecord> fixed_records;
+  for (int i=0; i<100000; ++i) {
+    const std::string station = std::to_string(1000 + rng() % 90000);
+    string_records.push_back(StringRecord{ station, double(i) });
+    fixed_records.push_back(FixedRecord{ miutil::FixedString<5>(station), double(i) });
+  }
+  std::cout << "-- sort " << string_records.size() << " records by station, "
+            << sizeof(StringRecord) << " vs " << sizeof(FixedRecord) << " bytes per record" << std::endl;
+
+  run("std::string", 0,
+      [&]() {
+        std::vector<StringRecord> r = string_records;
+        std::sort(r.begin(), r.end(), [](const StringRecord& a, const StringRecord& b) { return a.station < b.station; });
+        return r.front().value;
+      });
+  run("FixedString<5>", 0,
+      [&]() {
+        std::vector<FixedRecord> r = fixed_records;
+        std::sort(r.begin(), r.end(), [](const FixedRecord& a, const FixedRecord& b) { return a.station < b.station; });
+        return r.front().value;
+      });
+}
+
+void bench_builder()
+{
+  const std::string prefix = "/opdata/hirlam12/h12_";
+  std::cout << "-- file names from string, int and double" << std::endl;
+
+  run("ostringstream", 0,
+      [&]() {
+        size_t n = 0;
+        for (int i=0; i<100; ++i) {
+          std::ostringstream ost;
+          ost << prefix << i << '_' << i*0.25 << ".grb";
+          n += ost.str().size();
+        }
+        return n;
+      });
+  run("StringBuilder", 0,
+      [&]() {
+        size_t n = 0;
+        for (int i=0; i<100; ++i) {
+          const std::string name = miutil::StringBuilder() << prefix << i << '_' << i*0.25 << ".grb";
+          n += name.size();
+        }
+        return n;
+      });
+  miutil::StringBuffer sb;
+  run("StringBuffer, reused", 0,
+      [&]() {
+        size_t n = 0;
+        for (int i=0; i<100; ++i) {
+          sb.clear();
+          sb << prefix << i << '_' << i*0.25 << ".grb";
+          n += sb.size();
+        }
+        return n;
+      });
+}
+
+void bench_format()
+{
+  const miutil::miDate date(2013, 1, 31);
+  const char* formats[] = { "%Y-%m-%d", "%A %e. %B %Y", "/opdata/model/latest.grb" };
+  for (const char* f : formats) {
+    const std::string format = f;
+    std::cout << "-- '" << format << "'" << std::endl;
+    run("sequential replace", format.size(),
+        [&]() { return format_date_replace(date, format, "en").size(); });
+    run("miDate::format", format.size(),
+        [&]() { return date.format(format, "en", false).size(); });
+  }
+}
+
+void bench_time_format()
+{
+  const miutil::miTime time(2013, 1, 31, 12, 0, 0);
+  const char* formats[] = { "%Y-%m-%d %H:%M:%S", "%a %e. %b $autoclock", "$tz=CET %H:%M %tz" };
+  for (const char* f : formats) {
+    const std::string format = f;
+    std::cout << "-- '" << format << "'" << std::endl;
+    run("miTime::format", format.size(),
+        [&]() { return time.format(format, "en", false).size(); });
+    const miutil::TimeFormatter formatter(format, "en");
+    char buffer[64];
+    run("TimeFormatter", format.size(),
+        [&]() { return formatter.format(buffer, buffer + sizeof(buffer), time) - buffer; });
+  }
+}
+
+void bench_remove()
+{
+  const std::string record = make_record(64*1024 / 8, "\",\"");
+  std::cout << "-- remove quotes from " << record.size() << " bytes" << std::endl;
+
+  run("find + erase", record.size(),
+      [&]() { std::string t = record; remove_find_erase(t, '"'); return t.size(); });
+  run("miutil::remove", record.size(),
+      [&]() { std::string t = record; miutil::remove(t, '"'); return t.size(); });
+
+  const miutil::CharSet whitespace_quotes(" \t\r\n\"");
+  run("replace_squeeze whitespace and quotes", record.size(),
+      [&]() { std::string t = record; miutil::replace_squeeze(t, whitespace_quotes, ' '); return t.size(); });
+}
+
+void bench_case()
+{
+  const char* names[] = { "Blindern", "OSLO - BLINDERN", "air_temperature_2m;precipitation_amount;Relative Humidity",
+                          "TROMS\xc3\x98 - LANGN\xc3\x85SBUKTA" };
+  for (const char* n : names) {
+    const std::string name = n;
+    std::cout << "-- '" << name << "'" << std::endl;
+    run("boost to_lower_copy", name.size(),
+        [&]() { return boost::algorithm::to_lower_copy(name, std::locale::classic()).size(); });
+    run("to_lower", name.size(),
+        [&]() { return miutil::to_lower(name).size(); });
+    run("tolower latin1", name.size(),
+        [&]() { return to_lower_latin1_tolower(name).size(); });
+    run("to_lower_latin1", name.size(),
+        [&]() { return miutil::to_lower_latin1(name).size(); });
+    run("to_lower_utf8", name.size(),
+        [&]() { return miutil::to_lower_utf8(name).size(); });
+  }
+}
+
+void bench_utf8()
+{
+  std::string latin1;
+  for (int i=0; latin1.size() < (1 << 20); ++i)
+    latin1 += (i % 10 == 0) ? "Bl\xE5" "b\xE6rsyltet\xF8y;" : "Oslo-Blindern;18700;";
+  const std::string utf8 = miutil::from_latin1_to_utf8(latin1);
+  std::cout << "-- " << latin1.size() << " bytes latin1, " << utf8.size() << " bytes utf8" << std::endl;
+
+  run("latin1 -> utf8, bytewise", latin1.size(),
+      [&]() { return latin1_to_utf8_bytewise(latin1).size(); });
+  run("from_latin1_to_utf8", latin1.size(),
+      [&]() { return miutil::from_latin1_to_utf8(latin1).size(); });
+  run("from_utf8_to_latin1", utf8.size(),
+      [&]() { return miutil::from_utf8_to_latin1(utf8).size(); });
+  run("is_valid_utf8", utf8.size(),
+      [&]() { return size_t(miutil::is_valid_utf8(utf8)); });
+}
+
+void bench_validate()
+{
+  const size_t fields = 200;
+  const std::string record = make_record(fields, ",");
+  std::cout << "-- " << fields << " columns, " << record.size() << " bytes" << std::endl;
+
+  run("split + is_number", record.size(),
+      [&]() {
+        size_t valid = 0;
+        for (const std::string& t : miutil::split(record, ","))
+          valid += miutil::is_number(t);
+        return valid;
+      });
+  std::uint64_t mask[(fields + 63) / 64];
+  run("validate_columns", record.size(),
+      [&]() { return miutil::validate_columns(record, ",", true, mask, fields); });
+}
+
+const Benchmark benchmarks[] = {
+  { "find_first_of", bench_find_first_of },
+  { "split", bench_split },
+  { "protected", bench_protected },
+  { "lines", bench_lines },
+  { "ingest", bench_ingest },
+  { "columns", bench_columns },
+  { "fixed", bench_fixed },
+  { "fixedstring", bench_fixed_string },
+  { "builder", bench_builder },
+  { "join", bench_join },
+  { "icompare", bench_icompare },
+  { "intern", bench_intern },
+  { "format", bench_format },
+  { "timeformat", bench_time_format },
+  { "remove", bench_remove },
+  { "case", bench_case },
+  { "utf8", bench_utf8 },
+  { "validate", bench_validate },
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  for (const Benchmark& b : benchmarks) {
+    bool selected = (argc == 1);
+    for (int i=1; i<argc && !selected; ++i)
+      selected = (std::strcmp(argv[i], b.name) == 0);
+    if (selected) {
+      std::cout << "== " << b.name << std::endl;
+      b.function();
+    }
+  }
+  return 0;
+}
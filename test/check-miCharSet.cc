@@ -0,0 +1,108 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for the miutil::CharSet class
+
+#include "miCharSet.h"
+#include <gtest/gtest.h>
+
+using miutil::CharSet;
+
+namespace {
+std::uint64_t scalar_mask(const CharSet& cs, const std::string& text, size_t start)
+{
+  std::uint64_t m = 0;
+  for (size_t i=0; i<64 && start+i < text.size(); ++i)
+    if (cs.contains(text[start+i]))
+      m |= std::uint64_t(1) << i;
+  return m;
+}
+
+class CharSetEngineTest : public ::testing::TestWithParam<CharSet::Engine> {
+protected:
+  void SetUp() override
+    { previous = CharSet::engine(); }
+  void TearDown() override
+    { CharSet::selectEngine(previous); }
+
+  CharSet::Engine previous;
+};
+} // namespace
+
+TEST(CharSetTest, contains)
+{
+  const CharSet cs(" \t:");
+  EXPECT_TRUE(cs.contains(' '));
+  EXPECT_TRUE(cs.contains(':'));
+  EXPECT_FALSE(cs.contains('a'));
+  EXPECT_FALSE(cs.contains('\0'));
+  EXPECT_FALSE(cs.contains('\xE5'));
+
+  const CharSet hi("\xE5");
+  EXPECT_TRUE(hi.contains('\xE5'));
+}
+
+TEST(CharSetTest, find)
+{
+  const CharSet& ws = CharSet::whitespace();
+  EXPECT_EQ(2, ws.find_first_in("ab cd"));
+  EXPECT_EQ(std::string_view::npos, ws.find_first_in("abcd"));
+  EXPECT_EQ(2, ws.find_first_not_in(" \tcd"));
+  EXPECT_EQ(1, ws.find_last_not_in("ab \n"));
+  EXPECT_EQ(std::string_view::npos, ws.find_last_not_in(" \n"));
+
+  EXPECT_EQ("x y", miutil::trimmed_view("\t x y \r\n"));
+  EXPECT_EQ("", miutil::trimmed_view("  "));
+}
+
+TEST_P(CharSetEngineTest, mask)
+{
+  if (!CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  std::string text;
+  for (int i=0; i<300; ++i)
+    text += "ab: \t,xyz\xE5"[(i*7 + i/13) % 10];
+
+  for (const char* chars : { " \t", ":,", "abcdefghijklmnopqrstuvwxyz", "\xE5" }) {
+    const CharSet cs(chars);
+    for (size_t start = 0; start + 64 <= text.size(); start += 17)
+      EXPECT_EQ(scalar_mask(cs, text, start), cs.mask64(text.data() + start)) << chars << " @" << start;
+    EXPECT_EQ(scalar_mask(cs, text, 290), cs.mask(text.data() + 290, 10));
+
+    miutil::CharSetScanner scanner(cs, text);
+    for (size_t pos = 0; pos < text.size(); pos += 5) {
+      EXPECT_EQ(cs.find_first_in(text, pos), scanner.find_first_in(pos));
+      EXPECT_EQ(cs.find_first_not_in(text, pos), scanner.find_first_not_in(pos));
+      EXPECT_EQ(text.find_first_of(chars, pos), cs.find_first_in(text, pos));
+      EXPECT_EQ(text.find_first_not_of(chars, pos), cs.find_first_not_in(text, pos));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, CharSetEngineTest,
+                         ::testing::Values(CharSet::ENGINE_SCALAR, CharSet::ENGINE_SSE2, CharSet::ENGINE_AVX2));
@@ -0,0 +1,232 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for the in-place character transforms
+
+#include "miCharTransform.h"
+#include "miStringFunctions.h"
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace {
+std::string naive_remove(const std::string& text, const miutil::CharSet& chars)
+{
+  std::string out;
+  for (char c : text)
+    if (!chars.contains(c))
+      out += c;
+  return out;
+}
+
+std::string naive_squeeze(const std::string& text, const miutil::CharSet& chars, char that)
+{
+  std::string out;
+  bool in_run = false;
+  for (char c : text) {
+    if (!chars.contains(c)) {
+      out += c;
+      in_run = false;
+    } else if (!in_run) {
+      out += that;
+      in_run = true;
+    }
+  }
+  return out;
+}
+} // namespace
+
+TEST(miCharTransformTest, remove)
+{
+  std::string t = "\"quoted\", \"text\"";
+  miutil::remove(t, '"');
+  EXPECT_EQ("quoted, text", t);
+
+  t = "aaaa";
+  miutil::remove(t, 'a');
+  EXPECT_EQ("", t);
+
+  t = "";
+  miutil::remove(t, 'a');
+  EXPECT_EQ("", t);
+
+  t = "a\tb\rc\n";
+  miutil::remove_chars(t, miutil::CharSet("\t\r\n"));
+  EXPECT_EQ("abc", t);
+}
+
+TEST(miCharTransformTest, replace)
+{
+  std::string t = "a,b,,c";
+  miutil::replace(t, ',', ';');
+  EXPECT_EQ("a;b;;c", t);
+
+  miutil::replace_chars(t, miutil::CharSet("ac"), 'x');
+  EXPECT_EQ("x;b;;x", t);
+}
+
+TEST(miCharTransformTest, squeeze)
+{
+  std::string t = "  a \t b\n\nc ";
+  miutil::replace_squeeze(t, miutil::CharSet::whitespace(), ' ');
+  EXPECT_EQ(" a b c ", t);
+
+  t = "a,,b;,c";
+  miutil::replace_squeeze(t, miutil::CharSet(",;"), '|');
+  EXPECT_EQ("a|b|c", t);
+}
+
+TEST(miCharTransformTest, map)
+{
+  miutil::CharMap map;
+  map.set('a', 'A').set(miutil::CharSet("xyz"), '_');
+  EXPECT_EQ('A', map('a'));
+  EXPECT_EQ('b', map('b'));
+
+  std::string t = "abcxyz";
+  map.apply(t);
+  EXPECT_EQ("Abc___", t);
+}
+
+TEST(miCharTransformTest, random)
+{
+  // long texts, to cover several 64-byte blocks
+  std::mt19937 rng(3);
+  const miutil::CharSet sets[] = { miutil::CharSet("a"), miutil::CharSet("ab\""), miutil::CharSet("abcdefghijklmnopqrst") };
+  for (int i=0; i<200; ++i) {
+    std::string text(rng() % 300, ' ');
+    for (char& c : text)
+      c = 'a' + rng() % (1 + i % 26);
+    for (const miutil::CharSet& chars : sets) {
+      std::string r = text;
+      miutil::remove_chars(r, chars);
+      EXPECT_EQ(naive_remove(text, chars), r);
+
+      std::string s = text;
+      miutil::replace_squeeze(s, chars, '#');
+      EXPECT_EQ(naive_squeeze(text, chars, '#'), s);
+    }
+  }
+}
+
+namespace {
+char old_lower_latin1(char ch)
+{
+  unsigned char c = tolower(static_cast<unsigned char>(ch));
+  if ((c>=192 && c<=214) || (c>=216 && c<=222))
+    c+=32;
+  return c;
+}
+
+char old_upper_latin1(char ch)
+{
+  unsigned char c = toupper(static_cast<unsigned char>(ch));
+  if ((c>=224 && c<=246) || (c>=248 && c<=254))
+    c-=32;
+  return c;
+}
+
+char ascii_lower(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+char ascii_upper(char c)
+{
+  return (c >= 'a' && c <= 'z') ? c - 32 : c;
+}
+} // namespace
+
+class CaseConversionTest : public ::testing::TestWithParam<miutil::CharSet::Engine> {
+protected:
+  void SetUp() override
+    { previous = miutil::CharSet::engine(); }
+  void TearDown() override
+    { miutil::CharSet::selectEngine(previous); }
+
+  miutil::CharSet::Engine previous;
+};
+
+TEST_P(CaseConversionTest, all_bytes)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  // all 256 byte values, at all offsets relative to 16-byte blocks
+  std::string text;
+  for (int r=0; r<3; ++r) {
+    for (int i=0; i<256; ++i)
+      text += static_cast<char>((i * 7 + r) & 0xFF);
+    text += "ASCII only text, ASCII ONLY TEXT, ascii only text; ";
+  }
+  for (size_t offset=0; offset<17; ++offset) {
+    const std::string in = text.substr(offset);
+    std::string el = in, eu = in, ell = in, elu = in;
+    for (size_t i=0; i<in.size(); ++i) {
+      el[i] = ascii_lower(in[i]);
+      eu[i] = ascii_upper(in[i]);
+      ell[i] = old_lower_latin1(in[i]);
+      elu[i] = old_upper_latin1(in[i]);
+    }
+    EXPECT_EQ(el, miutil::to_lower(in));
+    EXPECT_EQ(eu, miutil::to_upper(in));
+    EXPECT_EQ(ell, miutil::to_lower_latin1(in));
+    EXPECT_EQ(elu, miutil::to_upper_latin1(in));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, CaseConversionTest,
+                         ::testing::Values(miutil::CharSet::ENGINE_SCALAR, miutil::CharSet::ENGINE_SSE2,
+                                           miutil::CharSet::ENGINE_AVX2));
+
+TEST_P(CaseConversionTest, utf8)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  const char* pairs[][2] = {
+    { "M\xc3\x84R", "m\xc3\xa4r" },                          // MÄR
+    { "L\xc3\x98RDAG \xc3\x85S", "l\xc3\xb8rdag \xc3\xa5s" }, // LØRDAG ÅS
+    { "\xc5\x81\xc3\x93" "D\xc5\xb9", "\xc5\x82\xc3\xb3" "d\xc5\xba" }, // ŁÓDŹ
+    { "\xc5\xb8", "\xc3\xbf" },                               // Ÿ
+    { "\xce\x91\xce\x98\xce\x97\xce\x9d\xce\x91", "\xce\xb1\xce\xb8\xce\xb7\xce\xbd\xce\xb1" }, // ΑΘΗΝΑ
+    { "\xd0\x9c\xd0\x9e\xd0\xa1\xd0\x9a\xd0\x92\xd0\x90 \xd0\x81", "\xd0\xbc\xd0\xbe\xd1\x81\xd0\xba\xd0\xb2\xd0\xb0 \xd1\x91" }, // МОСКВА Ё
+  };
+  for (const auto& p : pairs) {
+    // prefix to move the text across 16-byte boundaries
+    for (const std::string prefix : { "", "ASCII PREFIX 123", "ASCII PREFIX" }) {
+      const std::string upper = prefix + p[0], lower = miutil::to_lower(prefix) + p[1];
+      EXPECT_EQ(lower, miutil::to_lower_utf8(upper));
+      EXPECT_EQ(upper, miutil::to_upper_utf8(lower));
+    }
+  }
+
+  // unchanged: sharp s, final sigma in to_lower, euro sign, emoji, invalid bytes
+  const std::string unchanged = "\xc3\x9f \xcf\x82 \xe2\x82\xac \xf0\x9f\x98\x80 \xc3 \x80\xe5";
+  EXPECT_EQ(unchanged, miutil::to_lower_utf8(unchanged));
+  EXPECT_EQ("\xce\xa3", miutil::to_upper_utf8("\xcf\x82"));
+}
@@ -136,6 +136,53 @@ TEST(MiDateTest, format)
     }
 }
 
+TEST(MiDateTest, formatNames)
+{
+  const miDate d(2013, 1, 1);
+  EXPECT_EQ("13 1 2013-01-01 January Jan Tuesday Tue", d.format("%y %e %D %B %b %A %a", "en"));
+  EXPECT_EQ("januar jan tirsdag tir", d.format("%_B %_b %_A %_a", "no"));
+  EXPECT_EQ("no patterns here", d.format("no patterns here"));
+  EXPECT_EQ("%2013%%H", d.format("%%Y%%H"));
+}
+
+namespace {
+class UpperTranslations : public miDate::Translations {
+public:
+  const std::string& weekday(int, bool utf8) const override
+    { return utf8 ? day_utf8 : day_latin1; }
+  const std::string& shortweekday(int day, bool utf8) const override
+    { return weekday(day, utf8); }
+  const std::string& monthname(int, bool utf8) const override
+    { return utf8 ? month_utf8 : month_latin1; }
+  const std::string& shortmonthname(int month, bool utf8) const override
+    { return monthname(month, utf8); }
+
+  const std::string day_utf8 = "\xc3\x98STDAG", day_latin1 = "\xd8STDAG";
+  const std::string month_utf8 = "\xd0\x9c\xd0\x90\xd0\xa0\xd0\xa2", month_latin1 = "MARS";
+};
+} // namespace
+
+TEST(MiDateTest, formatLowercaseNames)
+{
+  miDate::installTranslation(std::make_shared<UpperTranslations>(), "xx-upper");
+  miDate::setDefaultLanguage("en");
+
+  const miDate d(2013, 3, 1);
+  EXPECT_EQ("\xc3\xb8stdag \xd0\xbc\xd0\xb0\xd1\x80\xd1\x82", d.format("%_A %_B", "xx-upper", true));
+  EXPECT_EQ("\xf8stdag mars", d.format("%_A %_B", "xx-upper", false));
+}
+
+TEST(MiClockTest, format)
+{
+  const miClock c(0, 5, 9);
+  EXPECT_EQ("00:05:09|00:05:09|12:05:09 PM", c.format("%X|%T|%r"));
+  EXPECT_EQ("0 12 05 09", c.format("%k %l %M %S"));
+  EXPECT_EQ("24:05", c.format("%H:%M $midnight24"));
+  EXPECT_EQ("x 24 y", c.format("x $midnight24 %k y"));
+  EXPECT_EQ("00", c.format("$30M"));
+  EXPECT_EQ("30", miClock(13, 45, 0).format("$30M"));
+}
+
 TEST(MiDateTest, formatWeekNumber)
 {
     {
@@ -151,3 +198,22 @@ TEST(MiTimeTest, FromText)
 
   EXPECT_EQ(miTime("20130101T225858"), t);
 }
+
+TEST(MiTimeTest, FromView)
+{
+  // parse from a part of a larger buffer, as read from a mapped file
+  const std::string line = "obs;2013-01-01T22:58:58Z;20130101;22:58;0";
+  const std::string_view text(line);
+  const miTime t(2013, 1, 1, 22, 58, 58);
+
+  EXPECT_EQ(t, miTime(text.substr(4, 20)));
+  EXPECT_TRUE(miTime::isValid(text.substr(4, 19)));
+  EXPECT_FALSE(miTime::isValid(text.substr(4, 15)));
+  EXPECT_EQ(miDate(2013, 1, 1), miDate(text.substr(25, 8)));
+  EXPECT_TRUE(miDate::isValid(text.substr(25, 8)));
+  EXPECT_EQ(miClock(22, 58, 0), miClock(text.substr(34, 5)));
+  EXPECT_FALSE(miClock::isValid(text.substr(34, 4)));
+
+  EXPECT_EQ(miTime(2013, 1, 1, 0, 0, 0), miTime(text.substr(25, 8)));
+  EXPECT_TRUE(miTime(text.substr(40)).undef());
+}
@@ -0,0 +1,127 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miFixedString.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+typedef miutil::FixedString<5> WmoId;
+typedef miutil::FixedString<4> IcaoId;
+
+static_assert(sizeof(WmoId) == 5, "no space besides the characters");
+static_assert(std::is_trivially_copyable<WmoId>::value, "records must be copyable with memcpy");
+
+TEST(miFixedStringTest, assign)
+{
+  const WmoId empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(0, empty.size());
+  EXPECT_EQ("", empty.view());
+
+  WmoId id("01384");
+  EXPECT_EQ(5, id.size());
+  EXPECT_EQ("01384", id.view());
+  EXPECT_EQ("01384", id.str());
+
+  EXPECT_TRUE(id.assign("184"));
+  EXPECT_EQ(3, id.size());
+  EXPECT_EQ("184", id);
+  EXPECT_EQ(std::string_view("184"), id);
+  EXPECT_NE(id, "1840");
+
+  EXPECT_FALSE(id.assign("1234567"));
+  EXPECT_EQ("12345", id);
+  EXPECT_EQ(WmoId("12345"), WmoId("12345678"));
+
+  id.clear();
+  EXPECT_EQ(empty, id);
+}
+
+TEST(miFixedStringTest, compare)
+{
+  const char* texts[] = { "", "A", "AB", "ABC", "ABCD", "ABD", "B", "a", "ENGM", "ENZV", "ENG" };
+  for (const char* a : texts) {
+    for (const char* b : texts) {
+      const IcaoId fa(a), fb(b);
+      const std::string sa(a), sb(b);
+      EXPECT_EQ(sa == sb, fa == fb) << a << '|' << b;
+      EXPECT_EQ(sa < sb, fa < fb) << a << '|' << b;
+      EXPECT_EQ(sa <= sb, fa <= fb) << a << '|' << b;
+      EXPECT_EQ(sa > sb, fa > fb) << a << '|' << b;
+    }
+  }
+
+  std::unordered_set<IcaoId> set { IcaoId("ENGM"), IcaoId("ENZV"), IcaoId("ENGM") };
+  EXPECT_EQ(2, set.size());
+  EXPECT_EQ(1, set.count(IcaoId("ENZV")));
+  EXPECT_EQ(std::hash<std::string_view>()("ENZV"), IcaoId("ENZV").hash());
+}
+
+TEST(miFixedStringTest, functions)
+{
+  miutil::FixedString<8> s(" ta \t");
+  miutil::trim(s, false, true);
+  EXPECT_EQ(" ta", s);
+  EXPECT_EQ("ta", miutil::trimmed(s));
+  EXPECT_EQ("", miutil::trimmed(miutil::FixedString<8>("   ")));
+  EXPECT_EQ("ta", miutil::trimmed(miutil::FixedString<8>("xxtax"), true, true, "x"));
+
+  EXPECT_EQ(" TA", miutil::to_upper(s));
+  miutil::to_upper_inplace(s);
+  EXPECT_EQ(" ta", miutil::to_lower(s));
+
+  IcaoId fields[3];
+  EXPECT_EQ(3, miutil::split_into(fields, 3, " ENGM,ENZV,, ENBRX,ENVA", ", "));
+  EXPECT_EQ("ENGM", fields[0]);
+  EXPECT_EQ("ENZV", fields[1]);
+  EXPECT_EQ("ENBR", fields[2]);
+
+  EXPECT_EQ(3, miutil::split_into(fields, 3, "TA;;RR", ";", false));
+  EXPECT_EQ("TA", fields[0]);
+  EXPECT_TRUE(fields[1].empty());
+  EXPECT_EQ("RR", fields[2]);
+  EXPECT_EQ(2, miutil::split_into(fields, 2, "PO UU FF"));
+  EXPECT_EQ("UU", fields[1]);
+}
+
+TEST(miFixedStringTest, sort)
+{
+  std::vector<WmoId> ids;
+  std::vector<std::string> strings;
+  for (int i=0; i<1000; ++i) {
+    const std::string s = std::to_string((i * 7919) % 100000);
+    ids.emplace_back(s);
+    strings.push_back(s);
+  }
+  std::sort(ids.begin(), ids.end());
+  std::sort(strings.begin(), strings.end());
+  for (size_t i=0; i<ids.size(); ++i)
+    EXPECT_EQ(strings[i], ids[i]);
+}
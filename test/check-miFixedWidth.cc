@@ -0,0 +1,93 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for fixed-width record extraction
+
+#include "miFixedWidth.h"
+#include <gtest/gtest.h>
+
+namespace {
+miutil::FixedWidthLayout station_layout()
+{
+  miutil::FixedWidthLayout layout;
+  EXPECT_TRUE(layout.add("id", 0, 5, miutil::FixedWidthLayout::DIGITS));
+  EXPECT_TRUE(layout.add("name", 6, 12, miutil::FixedWidthLayout::TEXT));
+  EXPECT_TRUE(layout.add("lat", 18, 7, miutil::FixedWidthLayout::DOUBLE));
+  EXPECT_TRUE(layout.add("lon", 25, 7, miutil::FixedWidthLayout::DOUBLE));
+  EXPECT_TRUE(layout.add("height", 32, 5, miutil::FixedWidthLayout::INT));
+  return layout;
+}
+} // namespace
+
+TEST(FixedWidthTest, layout)
+{
+  miutil::FixedWidthLayout layout = station_layout();
+  EXPECT_EQ(5, layout.size());
+  EXPECT_EQ(37, layout.record_length());
+  EXPECT_EQ(2, layout.index("lat"));
+  EXPECT_EQ(-1, layout.index("nosuchfield"));
+  EXPECT_EQ(2, layout.int_columns());
+  EXPECT_EQ(2, layout.double_columns());
+  EXPECT_EQ(1, layout.text_columns());
+
+  EXPECT_FALSE(layout.add("id", 40, 2, miutil::FixedWidthLayout::INT));
+  EXPECT_FALSE(layout.add("x", 40, 0, miutil::FixedWidthLayout::INT));
+  EXPECT_FALSE(layout.add("x", 40, 10, miutil::FixedWidthLayout::DIGITS));
+  EXPECT_EQ(5, layout.size());
+}
+
+TEST(FixedWidthTest, extract)
+{
+  const miutil::FixedWidthLayout layout = station_layout();
+  miutil::FixedWidthColumns columns(layout);
+
+  //                       0         1         2         3
+  //                       0123456789012345678901234567890123456
+  EXPECT_TRUE(columns.add("01492 OSLO BLIND.  59.94  10.72   94"));
+  EXPECT_TRUE(columns.add("01001 JAN MAYEN    70.94  -8.67    9"));
+  EXPECT_FALSE(columns.add("0A001 X           ab       1.5  -1")); // bad id and lat, short record
+  EXPECT_FALSE(columns.add("01001"));
+
+  ASSERT_EQ(4, columns.size());
+  const std::vector<int> ids = { 1492, 1001, miutil::FixedWidthColumns::undefined_int, 1001 };
+  EXPECT_EQ(ids, columns.ints(layout.index("id")));
+  const std::vector<std::string> names = { "OSLO BLIND.", "JAN MAYEN", "X", "" };
+  EXPECT_EQ(names, columns.texts(layout.index("name")).strings());
+
+  const std::vector<double>& lat = columns.doubles(layout.index("lat"));
+  EXPECT_EQ(59.94, lat[0]);
+  EXPECT_TRUE(std::isnan(lat[2]));
+  const std::vector<double>& lon = columns.doubles(layout.index("lon"));
+  EXPECT_EQ(-8.67, lon[1]);
+  EXPECT_EQ(1.5, lon[2]);
+  const std::vector<int> heights = { 94, 9, -1, miutil::FixedWidthColumns::undefined_int };
+  EXPECT_EQ(heights, columns.ints(layout.index("height")));
+
+  columns.clear();
+  EXPECT_EQ(0, columns.size());
+  EXPECT_TRUE(columns.ints(0).empty());
+}
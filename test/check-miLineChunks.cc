@@ -0,0 +1,103 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for newline-aligned chunks and parallel line parsing
+
+#include "miLineChunks.h"
+#include "miStringFunctions.h"
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+std::string make_lines(int count)
+{
+  std::string text;
+  for (int i=0; i<count; ++i)
+    text += std::to_string(i) + ((i % 3) ? "\n" : " x\r\n");
+  return text;
+}
+
+int parse_first(std::string_view line)
+{
+  return miutil::to_int(std::string(line.substr(0, line.find(' '))));
+}
+} // namespace
+
+TEST(miLineChunksTest, next_line)
+{
+  std::string_view text = "a\r\n\nb\nc", line;
+  std::vector<std::string> lines;
+  while (miutil::next_line(text, line))
+    lines.emplace_back(line);
+  const std::vector<std::string> expected = { "a", "", "b", "c" };
+  EXPECT_EQ(expected, lines);
+}
+
+TEST(miLineChunksTest, split_line_chunks)
+{
+  const std::string text = make_lines(1000);
+  for (size_t count : { 1, 2, 7, 64, 5000 }) {
+    const std::vector<std::string_view> chunks = miutil::split_line_chunks(text, count);
+    EXPECT_LE(chunks.size(), count);
+    std::string joined;
+    for (size_t i=0; i<chunks.size(); ++i) {
+      EXPECT_FALSE(chunks[i].empty());
+      if (i+1 < chunks.size()) {
+        EXPECT_EQ('\n', chunks[i].back());
+      }
+      joined += chunks[i];
+    }
+    EXPECT_EQ(text, joined);
+  }
+
+  EXPECT_TRUE(miutil::split_line_chunks("", 4).empty());
+  EXPECT_EQ(1, miutil::split_line_chunks("no newline at all", 4).size());
+}
+
+TEST(miLineChunksTest, parallel_parse_lines)
+{
+  const std::string text = make_lines(10000);
+  for (unsigned threads : { 1, 2, 3, 8 }) {
+    const std::vector<int> values = miutil::parallel_parse_lines<int>(text,
+        [](std::string_view line, std::vector<int>& out) { out.push_back(parse_first(line)); }, threads);
+    ASSERT_EQ(10000, values.size());
+    for (int i=0; i<10000; ++i)
+      ASSERT_EQ(i, values[i]);
+  }
+}
+
+TEST(miLineChunksTest, parallel_parse_lines_exception)
+{
+  const std::string text = make_lines(1000);
+  EXPECT_THROW(miutil::parallel_parse_lines<int>(text,
+      [](std::string_view line, std::vector<int>&) {
+        if (parse_first(line) == 500)
+          throw std::runtime_error("bad line");
+      }, 4), std::runtime_error);
+}
@@ -0,0 +1,133 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for miutil::LineReader
+
+#include "miLineReader.h"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+class LineReaderTest : public ::testing::TestWithParam<miutil::LineReader::Mode> {
+protected:
+  void SetUp() override
+    {
+      char name[] = "/tmp/putools-linereader-XXXXXX";
+      const int fd = mkstemp(name);
+      ASSERT_GE(fd, 0);
+      close(fd);
+      path = name;
+    }
+
+  void TearDown() override
+    { std::remove(path.c_str()); }
+
+  void write(const std::string& contents)
+    { std::ofstream(path, std::ios::binary) << contents; }
+
+  std::vector<std::string> read(std::size_t block_size=miutil::LineReader::DEFAULT_BLOCK_SIZE)
+    {
+      std::vector<std::string> lines;
+      miutil::LineReader reader(path, GetParam(), block_size);
+      EXPECT_TRUE(reader.is_open());
+      if (GetParam() == miutil::LineReader::MODE_READ) {
+        EXPECT_FALSE(reader.is_mapped());
+      }
+      for (std::string_view line : reader)
+        lines.emplace_back(line);
+      EXPECT_FALSE(reader.failed());
+      EXPECT_EQ(lines.size(), reader.line_number());
+      return lines;
+    }
+
+  std::string path;
+};
+
+} // namespace
+
+TEST_P(LineReaderTest, LineEndings)
+{
+  write("a b\nc\r\n\n d \r\nlast");
+  const std::vector<std::string> expected = { "a b", "c", "", " d ", "last" };
+  EXPECT_EQ(expected, read());
+  EXPECT_EQ(expected, read(3));
+}
+
+TEST_P(LineReaderTest, FinalNewline)
+{
+  write("one\ntwo\n");
+  const std::vector<std::string> expected = { "one", "two" };
+  EXPECT_EQ(expected, read());
+  EXPECT_EQ(expected, read(1));
+}
+
+TEST_P(LineReaderTest, Empty)
+{
+  write("");
+  EXPECT_TRUE(read().empty());
+
+  write("\n");
+  EXPECT_EQ(std::vector<std::string>(1), read());
+}
+
+TEST_P(LineReaderTest, LongLines)
+{
+  std::string contents;
+  std::vector<std::string> expected;
+  for (int i=0; i<100; ++i) {
+    expected.push_back(std::string(i*37, 'a' + (i % 26)));
+    contents += expected.back() + "\n";
+  }
+  write(contents);
+  EXPECT_EQ(expected, read(16));
+}
+
+TEST_P(LineReaderTest, Split)
+{
+  write("1 2 3\n  4   5\n");
+  miutil::LineReader reader(path, GetParam());
+  std::vector<std::string> tokens;
+  for (std::string_view line : reader)
+    miutil::for_each_token(line, miutil::whitespaces, true, [&](std::string_view t) { tokens.emplace_back(t); });
+  const std::vector<std::string> expected = { "1", "2", "3", "4", "5" };
+  EXPECT_EQ(expected, tokens);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, LineReaderTest,
+    ::testing::Values(miutil::LineReader::MODE_AUTO, miutil::LineReader::MODE_READ));
+
+TEST(LineReaderMissingTest, NotOpen)
+{
+  miutil::LineReader reader("/nonexistent/putools-linereader");
+  EXPECT_FALSE(reader.is_open());
+  std::string_view line;
+  EXPECT_FALSE(reader.next(line));
+}
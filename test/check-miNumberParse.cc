@@ -0,0 +1,202 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for the number parsing functions
+
+#include "miNumberParse.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+TEST(miNumberParseTest, parse_number)
+{
+  double d = -1;
+
+  const std::string text = " 1.5e2 ";
+  EXPECT_TRUE(miutil::parse_number(text.data(), text.data() + text.size(), d));
+  EXPECT_EQ(150, d);
+
+  int i = -1;
+  EXPECT_TRUE(miutil::parse_number(text.data(), text.data() + text.size(), i));
+  EXPECT_EQ(1, i);
+
+  const std::string bad = "1.5e";
+  EXPECT_FALSE(miutil::parse_number(bad.data(), bad.data() + bad.size(), d));
+  EXPECT_EQ(150, d);
+}
+
+TEST(miNumberParseTest, parse_digits)
+{
+  const std::string digits = "0123456789";
+  for (size_t b=0; b<digits.size(); ++b) {
+    for (size_t e=b+1; e<=digits.size() && e-b<=9; ++e) {
+      int v = -1;
+      EXPECT_TRUE(miutil::parse_digits(digits.data() + b, digits.data() + e, v));
+      EXPECT_EQ(std::stoi(digits.substr(b, e-b)), v);
+    }
+  }
+
+  const char* bad[] = { "", "1234567890", " 1", "+1", "12a", "1234567/", "12345678:" };
+  for (const char* t : bad) {
+    int v = -1;
+    EXPECT_FALSE(miutil::parse_digits(t, t + strlen(t), v)) << t;
+    EXPECT_EQ(-1, v);
+  }
+}
+
+TEST(miNumberParseTest, scan_ints)
+{
+  // same results as sscanf for the formats used by miDate, miClock and miTime
+  const char* texts[] = { "2024-02-29", "20240229", "2024-2-29", "12:34:56", "123456", "1:2", " 7",
+                          "-1-02-03", "+123", "12x4", "", "20240229123", "2024-02-2" };
+  const char* formats[] = { "%4d-%2d-%2d", "%4d%2d%2d", "%2d:%2d:%2d", "%2d%2d%2d", "%2d", "%4d%2d%2d%2d" };
+  for (const char* t : texts) {
+    for (const char* f : formats) {
+      int a[4] = { -7, -7, -7, -7 }, b[4] = { -7, -7, -7, -7 };
+      const int expected = std::max(0, sscanf(t, f, &a[0], &a[1], &a[2], &a[3]));
+      EXPECT_EQ(expected, miutil::scan_ints(t, f, { &b[0], &b[1], &b[2], &b[3] })) << t << " / " << f;
+      for (int i=0; i<4; ++i)
+        EXPECT_EQ(a[i], b[i]) << t << " / " << f << " #" << i;
+    }
+  }
+
+  // does not read past the end of the view
+  const std::string_view part = std::string_view("20240229").substr(0, 6);
+  int y = 0, m = 0, d = -7;
+  EXPECT_EQ(2, miutil::scan_ints(part, "%4d%2d%2d", { &y, &m, &d }));
+  EXPECT_EQ(2024, y);
+  EXPECT_EQ(2, m);
+  EXPECT_EQ(-7, d);
+}
+
+TEST(miNumberParseTest, is_number_grammar)
+{
+  // is_number must accept exactly what parse_number accepts; the digits
+  // are chosen to keep the values in range
+  const char chars[] = " -+.eE10x";
+  const int nchars = sizeof(chars) - 1;
+  std::string text;
+  for (int length=1; length<=5; ++length) {
+    int combinations = 1;
+    for (int i=0; i<length; ++i)
+      combinations *= nchars;
+    text.resize(length);
+    for (int c=0; c<combinations; ++c) {
+      for (int i=0, k=c; i<length; ++i, k /= nchars)
+        text[i] = chars[k % nchars];
+      const char* begin = text.data();
+      const char* end = begin + text.size();
+      double d;
+      long l;
+      const bool integer = text.find_first_of(".eE") == std::string::npos;
+      EXPECT_EQ(miutil::parse_number(begin, end, d), miutil::is_number(begin, end)) << '"' << text << '"';
+      EXPECT_EQ(integer && miutil::parse_number(begin, end, l), miutil::is_int(begin, end)) << '"' << text << '"';
+    }
+  }
+}
+
+TEST(miNumberParseTest, validate)
+{
+  const std::string_view fields[] = { "1", " -2.5e3 ", "x", "", "7.", "+8" };
+  std::uint64_t mask = 0xFF;
+  EXPECT_EQ(4, miutil::validate_numbers(fields, 6, &mask));
+  EXPECT_EQ(0x33u, mask);
+  EXPECT_EQ(2, miutil::validate_numbers(fields, 6, &mask, true));
+  EXPECT_EQ(0x21u, mask);
+
+  std::uint64_t masks[2] = { 0, 0 };
+  std::string record;
+  for (int i=0; i<70; ++i)
+    record += (i == 3 || i == 66) ? "n/a;" : "12.5;";
+  EXPECT_EQ(70, miutil::validate_columns(record, ";", true, masks, 80));
+  EXPECT_EQ(~std::uint64_t(0) & ~std::uint64_t(8), masks[0]);
+  EXPECT_EQ(0x3Bu, masks[1]);
+
+  EXPECT_EQ(2, miutil::validate_columns("1,,x,4", ",", false, masks, 2, true));
+  EXPECT_EQ(1u, masks[0]);
+}
+
+TEST(miNumberParseTest, parse_columns)
+{
+  double values[6];
+  std::fill(values, values + 6, 99.0);
+
+  EXPECT_EQ(5, miutil::parse_columns("1.5 -2  x 1e3 +.25", miutil::whitespaces, true, values, 6, -1.0));
+  EXPECT_EQ(1.5,  values[0]);
+  EXPECT_EQ(-2,   values[1]);
+  EXPECT_EQ(-1,   values[2]);
+  EXPECT_EQ(1000, values[3]);
+  EXPECT_EQ(0.25, values[4]);
+  EXPECT_EQ(99,   values[5]);
+
+  float fvalues[3];
+  EXPECT_EQ(3, miutil::parse_columns("1,, 2.5 ,rest", ",", false, fvalues, 3));
+  EXPECT_EQ(1,    fvalues[0]);
+  EXPECT_TRUE(std::isnan(fvalues[1]));
+  EXPECT_EQ(2.5f, fvalues[2]);
+}
+
+TEST(miNumberParseTest, parse_columns_exact)
+{
+  // compare fast path with from_chars for many plain decimals
+  std::mt19937_64 rng(42);
+  std::string line;
+  std::vector<std::string> fields;
+  for (int i=0; i<2000; ++i) {
+    std::string f;
+    if (rng() % 2)
+      f += '-';
+    f += std::to_string(rng() % (rng() % 2 ? 1000 : 100000000000000ull));
+    if (rng() % 4) {
+      f += '.';
+      const int nfrac = rng() % 12;
+      for (int k=0; k<nfrac; ++k)
+        f += char('0' + rng() % 10);
+    }
+    fields.push_back(f);
+    line += f;
+    line += ' ';
+  }
+
+  std::vector<double> values(fields.size());
+  std::vector<float> fvalues(fields.size());
+  ASSERT_EQ(fields.size(), miutil::parse_columns(line, " ", true, values.data(), values.size()));
+  ASSERT_EQ(fields.size(), miutil::parse_columns(line, " ", true, fvalues.data(), fvalues.size()));
+  for (size_t i=0; i<fields.size(); ++i) {
+    const std::string& f = fields[i];
+    double expected;
+    std::from_chars(f.data(), f.data() + f.size(), expected);
+    EXPECT_EQ(expected, values[i]) << f;
+    float fexpected;
+    std::from_chars(f.data(), f.data() + f.size(), fexpected);
+    EXPECT_EQ(fexpected, fvalues[i]) << f;
+  }
+}
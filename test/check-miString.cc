@@ -31,6 +31,11 @@
 #include "miString.h"
 #include <gtest/gtest.h>
 
+#include <iomanip>
+#include <list>
+#include <set>
+#include <string_view>
+
 using miutil::miString;
 
 TEST(miStringTest, ctor)
@@ -201,6 +206,14 @@ TEST(miStringTest, to_int)
     EXPECT_EQ(-1, miutil::to_int("", -1));
 
     EXPECT_EQ(12, miutil::to_int("12.3"));
+
+    // views need not be terminated
+    const std::string_view digits = "12345";
+    EXPECT_EQ(123, miutil::to_int(digits.substr(0, 3)));
+    EXPECT_EQ(2.5, miutil::to_double(std::string_view("2.5e1").substr(0, 3)));
+    EXPECT_TRUE(miutil::is_int(digits.substr(1, 2)));
+    EXPECT_TRUE(miutil::contains(digits.substr(1), "45"));
+    EXPECT_FALSE(miutil::contains(digits.substr(0, 4), "45"));
 }
 
 TEST(miStringTest, to_double)
@@ -218,6 +231,136 @@ TEST(miStringTest, to_double)
   EXPECT_FLOAT_EQ(0.03, miutil::to_double("0.03"));
 }
 
+TEST(miStringTest, to_number_grammar)
+{
+  EXPECT_EQ(-12, miutil::to_int(" -12.9e3 "));
+  EXPECT_EQ(0,   miutil::to_int("-.5"));
+  EXPECT_EQ(7,   miutil::to_int("+7"));
+  EXPECT_EQ(-1,  miutil::to_int("99999999999", -1));
+  EXPECT_EQ(99999999999L, miutil::to_long("99999999999"));
+
+  EXPECT_EQ(-5000, miutil::to_double("-5.E3"));
+  EXPECT_EQ(0.5,   miutil::to_double("+.5"));
+  EXPECT_EQ(-1,    miutil::to_double(".", -1));
+  EXPECT_EQ(-1,    miutil::to_double("+-1", -1));
+  EXPECT_EQ(-1,    miutil::to_double("1e", -1));
+  EXPECT_EQ(-1,    miutil::to_double("1e+", -1));
+  EXPECT_EQ(-1,    miutil::to_double("1.2.3", -1));
+  EXPECT_EQ(-1,    miutil::to_double("inf", -1));
+  EXPECT_EQ(-1,    miutil::to_double("0x10", -1));
+  EXPECT_EQ(-1,    miutil::to_double("1e999", -1));
+  EXPECT_TRUE(std::isnan(miutil::to_double("nan")));
+
+  EXPECT_FLOAT_EQ(0.1f, miutil::to_float("0.1"));
+  EXPECT_EQ(-1,         miutil::to_float("", -1));
+}
+
+TEST(miStringTest, to_number_length)
+{
+  const char line[] = "12.5;17;x";
+  EXPECT_EQ(12.5, miutil::to_double(line, 4, -1));
+  EXPECT_EQ(12,   miutil::to_int(line, 4, -1));
+  EXPECT_EQ(17,   miutil::to_long(line + 5, 2, -1));
+  EXPECT_EQ(1,    miutil::to_float(line + 5, 1, -1));
+  EXPECT_EQ(-1,   miutil::to_double(line + 5, 4, -1));
+  EXPECT_EQ(-1,   miutil::to_int(line, 0, -1));
+}
+
+TEST(miStringTest, from_number)
+{
+  for (int i : { 0, 7, -7, 42, -123, 99999, INT_MAX, INT_MIN }) {
+    for (int width : { 0, 1, 2, 4, 12, 20 }) {
+      for (char fill : { '0', ' ' }) {
+        std::ostringstream ost;
+        if (width > 0)
+          ost << std::setw(width) << std::setfill(fill);
+        ost << i;
+        EXPECT_EQ(ost.str(), miutil::from_number(i, width, fill)) << i << ' ' << width;
+      }
+    }
+  }
+
+  for (double d : { 0.0, -0.0, 0.1, 1.0/3, -2.5e-7, 123456.0, 1234567.0, 1e300, -1e-300 }) {
+    for (int prec : { -1, 0, 1, 3, 6, 12, 17, 40 }) {
+      std::ostringstream ost;
+      if (prec != -1)
+        ost.precision(prec);
+      ost << d;
+      EXPECT_EQ(ost.str(), miutil::from_number(d, prec)) << d << ' ' << prec;
+
+      std::ostringstream ostf;
+      if (prec != -1)
+        ostf.precision(prec);
+      ostf << float(d);
+      EXPECT_EQ(ostf.str(), miutil::from_number(float(d), prec)) << d << ' ' << prec;
+    }
+  }
+
+  EXPECT_EQ("0.1", miutil::from_number(0.1, miutil::PRECISION_SHORTEST));
+  EXPECT_EQ("0.3333333333333333", miutil::from_number(1.0/3, miutil::PRECISION_SHORTEST));
+  EXPECT_EQ("0.1", miutil::from_number(0.1f, miutil::PRECISION_SHORTEST));
+}
+
+TEST(miStringTest, append_number)
+{
+  std::string text = "T";
+  miutil::append_number(text, 5, 3);
+  text += '_';
+  miutil::append_number(text, -1.5);
+  text += '_';
+  miutil::append_number(text, 2.25f, miutil::PRECISION_SHORTEST);
+  EXPECT_EQ("T005_-1.5_2.25", text);
+
+  char buffer[4];
+  EXPECT_EQ(buffer + 3, miutil::format_number(buffer, buffer + sizeof(buffer), 12, 3));
+  EXPECT_EQ("012", std::string(buffer, 3));
+  EXPECT_EQ(nullptr, miutil::format_number(buffer, buffer + sizeof(buffer), 12345));
+  EXPECT_EQ(nullptr, miutil::format_number(buffer, buffer + sizeof(buffer), 1.0/3));
+}
+
+TEST(miStringTest, join)
+{
+  const std::vector<std::string> words = { "a", "bc", "", "def" };
+  EXPECT_EQ("a, bc, , def", miutil::join(words, ", "));
+  EXPECT_EQ("a bc  def", miutil::join(words));
+  EXPECT_EQ("", miutil::join(std::vector<std::string>(), ","));
+
+  const std::string_view views[] = { "x", "y" };
+  EXPECT_EQ("x-y", miutil::join(views, "-"));
+  const std::set<const char*> one = { "one" };
+  EXPECT_EQ("one", miutil::join(one, "-"));
+}
+
+TEST(miStringTest, join_numbers)
+{
+  const std::vector<int> ints = { 1, -20, 300, INT_MIN };
+  EXPECT_EQ("1,-20,300,-2147483648", miutil::join_numbers(ints, ","));
+  const std::list<double> doubles = { 0.5, -1.0/3, 1e-5, 12345678 };
+  EXPECT_EQ("0.5 -0.333333 1e-05 1.23457e+07", miutil::join_numbers(doubles));
+  EXPECT_EQ("0.5 -0.33 1e-05 1.2e+07", miutil::join_numbers(doubles, " ", 2));
+  EXPECT_EQ("", miutil::join_numbers(std::vector<float>()));
+}
+
+TEST(miStringTest, join_deprecated)
+{
+  // miString::join used to go through an ostringstream for all types
+  const std::vector<double> doubles = { 0.5, -1.0/3, 1e-5, 12345678, 1e300 };
+  std::ostringstream ost;
+  for (size_t i=0; i<doubles.size(); ++i)
+    ost << (i ? ":" : "") << doubles[i];
+  miString joined;
+  joined.join(doubles, ":");
+  EXPECT_EQ(ost.str(), joined);
+
+  const std::set<std::string> words = { "b", "a" };
+  joined.join(words, ", ");
+  EXPECT_EQ("a, b", joined);
+
+  const std::vector<char> chars = { 'x', 'y' };
+  joined.join(chars);
+  EXPECT_EQ("x y", joined);
+}
+
 TEST(miStringTest, to_upper_lower)
 {
     EXPECT_EQ(" RIKTIG", miutil::to_upper(" riKTiG"));
@@ -238,6 +381,25 @@ TEST(miStringTest, to_upper_lower)
 #endif
 }
 
+TEST(miStringTest, to_upper_lower_inplace)
+{
+  std::string t = "Oslo Blindern \xC5S";
+  miutil::to_lower_inplace(t);
+  EXPECT_EQ("oslo blindern \xC5s", t);
+  miutil::to_upper_latin1_inplace(t);
+  EXPECT_EQ("OSLO BLINDERN \xC5S", t);
+  miutil::to_lower_latin1_inplace(t);
+  EXPECT_EQ("oslo blindern \xE5s", t);
+  miutil::to_upper_inplace(t);
+  EXPECT_EQ("OSLO BLINDERN \xE5S", t);
+
+  std::string long_name(100, 'X');
+  const char* data = long_name.data();
+  const std::string lowered = miutil::to_lower(std::move(long_name));
+  EXPECT_EQ(std::string(100, 'x'), lowered);
+  EXPECT_EQ(data, lowered.data()); // buffer moved, not copied
+}
+
 TEST(miStringTest, Latin1ToUtf8)
 {
   EXPECT_EQ("blåbær", miutil::from_latin1_to_utf8("bl\xE5" "b\xE6" "r"));
@@ -1,5 +1,5 @@
 /*
- * Test cases for the miutil::StringBuilder class
+ * Test cases for the miutil::StringBuilder and miutil::StringBuffer classes
  */
 
 #ifdef HAVE_CONFIG_H
@@ -10,8 +10,76 @@
 #include "miStringBuilder.h"
 #include <gtest/gtest.h>
 
+#include <iomanip>
+
 TEST(miStringBuilderTest, simple)
 {
   const std::string message = (miutil::StringBuilder() << "five plus " << 2 << " is seven");
   ASSERT_EQ("five plus 2 is seven", message);
 }
+
+TEST(miStringBuilderTest, manipulators)
+{
+  miutil::StringBuilder sb;
+  sb << std::setw(2) << std::setfill('0') << 5 << ' ' << std::hex << 255 << ' ' << std::setprecision(3) << 3.14159;
+  EXPECT_EQ("05 ff 3.14", sb.str());
+
+  static_assert(miutil::detail::is_stream_manipulator<decltype(std::setw(2))>::value, "setw");
+  static_assert(miutil::detail::is_stream_manipulator<decltype(std::setfill('0'))>::value, "setfill");
+  static_assert(miutil::detail::is_stream_manipulator<decltype(std::setprecision(3))>::value, "setprecision");
+  static_assert(miutil::detail::is_stream_manipulator<std::ios_base&(std::ios_base&)>::value, "hex");
+  static_assert(!miutil::detail::is_stream_manipulator<int>::value, "int");
+}
+
+namespace {
+struct Point {
+  int x, y;
+};
+std::ostream& operator<<(std::ostream& out, const Point& p)
+{
+  return out << '(' << p.x << ',' << p.y << ')';
+}
+} // namespace
+
+TEST(miStringBufferTest, types)
+{
+  const std::string s1 = miutil::StringBuffer() << 'c' << -17 << ' ' << 123456789012LL << ' ' << 42u << ' ' << true;
+  EXPECT_EQ("c-17 123456789012 42 1", s1);
+
+  const std::string_view sv("view");
+  const char* null = nullptr;
+  const std::string s2 = miutil::StringBuffer() << std::string("str") << sv << null << "lit";
+  EXPECT_EQ("strviewlit", s2);
+
+  const std::string s3 = miutil::StringBuffer() << Point{3, -4};
+  EXPECT_EQ("(3,-4)", s3);
+}
+
+TEST(miStringBufferTest, floating)
+{
+  const double values[] = { 0, -0.5, 0.1, 1.0/3, 1e-5, 123456, 1234567, 1e100, -2.5e-300 };
+  for (double v : values) {
+    std::ostringstream ost;
+    ost << v << ' ' << float(v);
+    const std::string sb = miutil::StringBuffer() << v << ' ' << float(v);
+    EXPECT_EQ(ost.str(), sb) << v;
+  }
+}
+
+TEST(miStringBufferTest, reuse)
+{
+  miutil::StringBuffer sb(64);
+  sb << "file_" << 1 << ".txt";
+  EXPECT_EQ("file_1.txt", sb.str());
+  EXPECT_EQ(10u, sb.size());
+
+  const char* data = sb.view().data();
+  sb.clear();
+  EXPECT_TRUE(sb.empty());
+  sb << "file_" << 2 << ".txt";
+  EXPECT_EQ("file_2.txt", sb.view());
+  EXPECT_EQ(data, sb.view().data()); // no reallocation
+
+  const std::string moved = std::move(sb).str();
+  EXPECT_EQ("file_2.txt", moved);
+}
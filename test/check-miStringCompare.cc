@@ -0,0 +1,158 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for case-insensitive comparison
+
+#include "miStringCompare.h"
+#include "miCharSet.h"
+#include "miStringFunctions.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_set>
+
+namespace {
+int sign(int i)
+{
+  return (i > 0) - (i < 0);
+}
+
+std::string random_text(std::mt19937& rng, size_t length, const std::string& alphabet)
+{
+  std::string text;
+  for (size_t i=0; i<length; ++i)
+    text += alphabet[rng() % alphabet.size()];
+  return text;
+}
+
+// mixes case of some letters, latin1 only if latin1 is true
+std::string change_case(std::string text, std::mt19937& rng, bool latin1)
+{
+  for (char& c : text) {
+    const unsigned char u = c;
+    if (rng() % 2 && ((u >= 'a' && u <= 'z') || (latin1 && u >= 0xE0 && u <= 0xFE && u != 0xF7)))
+      c = u - 0x20;
+  }
+  return text;
+}
+} // namespace
+
+class StringCompareTest : public ::testing::TestWithParam<miutil::CharSet::Engine> {
+protected:
+  void SetUp() override
+    { previous = miutil::CharSet::engine(); }
+  void TearDown() override
+    { miutil::CharSet::selectEngine(previous); }
+
+  miutil::CharSet::Engine previous;
+};
+
+TEST_P(StringCompareTest, ascii)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  EXPECT_TRUE(miutil::iequals("Oslo-Blindern", "OSLO-blindern"));
+  EXPECT_FALSE(miutil::iequals("Oslo", "Osl"));
+  EXPECT_FALSE(miutil::iequals("@", "`"));
+  EXPECT_FALSE(miutil::iequals("\xC5", "\xE5"));
+  EXPECT_TRUE(miutil::iequals_latin1("\xC5s", "\xE5S"));
+  EXPECT_FALSE(miutil::iequals_latin1("\xD7", "\xF7"));
+
+  EXPECT_EQ(0, miutil::icompare("abc", "ABC"));
+  EXPECT_GT(0, miutil::icompare("ab", "ABC"));
+  EXPECT_LT(0, miutil::icompare("b", "ABC"));
+  EXPECT_LT(0, miutil::icompare("Z", "_")); // compares as 'z' > '_'
+
+  EXPECT_TRUE(miutil::istarts_with("Station:", "STAT"));
+  EXPECT_FALSE(miutil::istarts_with("Sta", "STAT"));
+  EXPECT_EQ(miutil::ihash("Blindern Observatory, Oslo"), miutil::ihash("BLINDERN OBSERVATORY, OSLO"));
+}
+
+TEST_P(StringCompareTest, random)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  std::mt19937 rng(19);
+  const std::string alphabet = "abcxyzABCXYZ@[`{ 09\xC0\xD7\xDE\xE0\xF7\xFE\xFF";
+  for (int i=0; i<2000; ++i) {
+    const std::string a = random_text(rng, rng() % 40, alphabet);
+    const bool latin1 = (i % 2);
+    std::string b = change_case(a, rng, latin1);
+    if (i % 3 == 0 && !b.empty())
+      b[rng() % b.size()] = alphabet[rng() % alphabet.size()];
+
+    const std::string la = miutil::to_lower(a), lb = miutil::to_lower(b);
+    EXPECT_EQ(la == lb, miutil::iequals(a, b)) << a << '|' << b;
+    EXPECT_EQ(sign(la.compare(lb)), sign(miutil::icompare(a, b))) << a << '|' << b;
+    EXPECT_EQ(lb.compare(0, la.size(), la) == 0 && la.size() <= lb.size(), miutil::istarts_with(b, a));
+    if (la == lb) {
+      EXPECT_EQ(miutil::ihash(a), miutil::ihash(b));
+    }
+
+    const std::string l1a = miutil::to_lower_latin1(a), l1b = miutil::to_lower_latin1(b);
+    EXPECT_EQ(l1a == l1b, miutil::iequals_latin1(a, b)) << a << '|' << b;
+    EXPECT_EQ(sign(l1a.compare(l1b)), sign(miutil::icompare_latin1(a, b))) << a << '|' << b;
+    if (l1a == l1b) {
+      EXPECT_EQ(miutil::ihash_latin1(a), miutil::ihash_latin1(b));
+    }
+  }
+}
+
+TEST_P(StringCompareTest, hash_engine_independent)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  const std::string text = "Case-Insensitive Hash Of A Longer Text";
+  const size_t h = miutil::ihash(text);
+  miutil::CharSet::selectEngine(miutil::CharSet::ENGINE_SCALAR);
+  EXPECT_EQ(h, miutil::ihash(text));
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, StringCompareTest,
+                         ::testing::Values(miutil::CharSet::ENGINE_SCALAR, miutil::CharSet::ENGINE_SSE2,
+                                           miutil::CharSet::ENGINE_AVX2));
+
+TEST(StringCompareFunctorTest, containers)
+{
+  const std::map<std::string, int, miutil::iless> m = { { "Oslo", 1 }, { "bergen", 2 } };
+  EXPECT_EQ(1, m.at("OSLO"));
+  const std::string_view key = "BERGEN";
+  ASSERT_NE(m.end(), m.find(key));
+  EXPECT_EQ(2, m.find(key)->second);
+
+  const std::set<std::string, miutil::iless> s = { "a", "B", "A" };
+  EXPECT_EQ(2, s.size());
+
+  std::unordered_set<std::string, miutil::ihasher, miutil::iequal_to> u = { "Tromsø", "TROMSø" };
+  EXPECT_EQ(1, u.size());
+  EXPECT_EQ(1, u.count("tromsø"));
+}
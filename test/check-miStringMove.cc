@@ -0,0 +1,148 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Checks that the rvalue overloads reuse buffers; counts allocations by
+// replacing the global operator new for the whole test program
+
+#include "miString.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<long> allocations(0);
+
+class AllocationCounter {
+public:
+  AllocationCounter()
+    : start_(allocations.load()) {}
+  long count() const
+    { return allocations.load() - start_; }
+
+private:
+  long start_;
+};
+
+// longer than any small-string buffer
+const char text[] = "  Some Text That Does Not Fit Into A Small String Buffer \t";
+const char lower_trimmed[] = "some text that does not fit into a small string buffer";
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  allocations += 1;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+TEST(miStringMoveTest, pipeline)
+{
+  std::string s = text;
+  const char* buffer = s.data();
+
+  const AllocationCounter counter;
+  const std::string r = miutil::trimmed(miutil::to_lower(std::move(s)));
+  const std::string r1 = miutil::trimmed(miutil::to_lower_latin1(std::string(r)));
+  const long count = counter.count();
+
+  EXPECT_EQ(1, count); // the explicit copy
+  EXPECT_EQ(lower_trimmed, r);
+  EXPECT_EQ(buffer, r.data());
+  EXPECT_EQ(r, r1);
+}
+
+TEST(miStringMoveTest, trim)
+{
+  std::string s = text;
+  std::vector<std::string> v { text, "  ", text, "" };
+  v.reserve(8);
+
+  const AllocationCounter counter;
+  miutil::trim(s);
+  miutil::trim_remove_empty(v);
+  const std::string t = miutil::trimmed(static_cast<const std::string&>(s), true, true, "S");
+  const long count = counter.count();
+
+  EXPECT_EQ(1, count); // only the result of the const overload of trimmed
+  EXPECT_EQ(s, miutil::trimmed(std::string(text)));
+  ASSERT_EQ(2, v.size());
+  EXPECT_EQ(s, v[0]);
+  EXPECT_EQ(s, v[1]);
+  EXPECT_EQ(s.substr(1), t);
+}
+
+TEST(miStringMoveTest, appended)
+{
+  std::string a = text;
+  const std::string b = text;
+  const std::string separator = ", ";
+
+  const AllocationCounter counter;
+  const std::string c = miutil::appended(a, separator, b);
+  const long count_copy = counter.count();
+  a.reserve(c.size());
+  const char* buffer = a.data();
+  const AllocationCounter counter_move;
+  const std::string d = miutil::appended(std::move(a), separator, b);
+  miutil::appendTo(a, separator, b);
+  const long count_move = counter_move.count();
+
+  EXPECT_EQ(1, count_copy);
+  EXPECT_EQ(1, count_move); // appendTo to the moved-from, empty string
+  EXPECT_EQ(std::string(text) + ", " + text, c);
+  EXPECT_EQ(c, d);
+  EXPECT_EQ(buffer, d.data());
+  EXPECT_EQ(b, a);
+  EXPECT_EQ(b, miutil::appended(std::string(), separator, b));
+  EXPECT_EQ(b, miutil::appended(b, separator, std::string()));
+}
+
+TEST(miStringMoveTest, miString)
+{
+  std::string s = text;
+  const char* buffer = s.data();
+
+  const AllocationCounter counter;
+  const miutil::miString m(std::move(s));
+  const long count = counter.count();
+
+  EXPECT_EQ(0, count);
+  EXPECT_EQ(buffer, m.data());
+}
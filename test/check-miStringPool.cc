@@ -0,0 +1,149 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "miStringPool.h"
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+TEST(miStringPoolTest, intern)
+{
+  miutil::StringPool pool;
+  std::string a = "01384";
+  const miutil::PooledString pa = pool.intern(a);
+  a[0] = 'x'; // the pool keeps its own copy
+  const miutil::PooledString pb = pool.intern(std::string_view("01384 OSLO").substr(0, 5));
+  const miutil::PooledString pc = pool.intern("TA");
+
+  EXPECT_EQ(pa, pb);
+  EXPECT_NE(pa, pc);
+  EXPECT_EQ(pa.view().data(), pb.view().data());
+  EXPECT_EQ("01384", pa.view());
+  EXPECT_STREQ("01384", pa.c_str());
+  EXPECT_EQ(5, pa.size());
+  EXPECT_EQ(std::hash<std::string_view>()("01384"), pa.hash());
+  EXPECT_TRUE(pa < pc);
+  EXPECT_FALSE(pc < pa);
+  EXPECT_FALSE(pa < pb);
+  EXPECT_EQ(2, pool.size());
+
+  EXPECT_EQ(pc, pool.find("TA"));
+  EXPECT_TRUE(pool.find("RR").empty());
+  EXPECT_EQ(2, pool.size());
+
+  const miutil::PooledString empty = pool.intern("");
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(miutil::PooledString(), empty);
+  EXPECT_STREQ("", empty.c_str());
+  EXPECT_EQ(2, pool.size());
+}
+
+TEST(miStringPoolTest, many)
+{
+  miutil::StringPool pool;
+  std::vector<miutil::PooledString> pooled;
+  for (int i=0; i<20000; ++i)
+    pooled.push_back(pool.intern(std::to_string(i)));
+  const std::string long_text(50000, 'x');
+  const miutil::PooledString long_pooled = pool.intern(long_text);
+  EXPECT_EQ(20001, pool.size());
+  EXPECT_LT(20000 * 6, pool.memory());
+
+  std::unordered_set<miutil::PooledString> set;
+  for (int i=0; i<20000; ++i) {
+    const miutil::PooledString p = pool.intern(std::to_string(i));
+    EXPECT_EQ(pooled[i], p);
+    EXPECT_EQ(std::to_string(i), p.view());
+    set.insert(p);
+  }
+  EXPECT_EQ(20000, set.size());
+  EXPECT_EQ(long_pooled, pool.intern(long_text));
+  EXPECT_EQ(long_text, long_pooled.view());
+}
+
+TEST(miStringPoolTest, medium)
+{
+  // texts longer than the first block, but not long enough for a block of their own
+  std::vector<std::string> texts;
+  for (std::size_t size : { 1000, 1100, 2000, 4096, 8000, 12000, 16000, 16384, 17000 })
+    texts.push_back(std::string(size, char('a' + texts.size())));
+
+  miutil::StringPool pool;
+  std::vector<miutil::PooledString> pooled;
+  for (const std::string& t : texts)
+    pooled.push_back(pool.intern(t));
+  for (const std::string& t : texts)
+    pooled.push_back(pool.intern(t + "!"));
+  EXPECT_EQ(2 * texts.size(), pool.size());
+  for (std::size_t i=0; i<texts.size(); ++i) {
+    EXPECT_EQ(texts[i], pooled[i].view());
+    EXPECT_EQ(texts[i] + "!", pooled[texts.size() + i].view());
+    EXPECT_EQ(pooled[i], pool.find(texts[i]));
+  }
+}
+
+TEST(miStringPoolTest, bulk)
+{
+  miutil::StringPool pool;
+  const miutil::PooledString ta = pool.intern("TA");
+
+  miutil::TokenBuffer tokens;
+  miutil::split_into(tokens, "01384;TA;;TA;RR;degC", ";", false);
+  const std::vector<miutil::PooledString> pooled = pool.intern(tokens);
+  ASSERT_EQ(6, pooled.size());
+  EXPECT_EQ("01384", pooled[0].view());
+  EXPECT_EQ(ta, pooled[1]);
+  EXPECT_TRUE(pooled[2].empty());
+  EXPECT_EQ(ta, pooled[3]);
+  EXPECT_EQ(pool.find("RR"), pooled[4]);
+  EXPECT_EQ("degC", pooled[5].view());
+  EXPECT_EQ(4, pool.size());
+}
+
+TEST(miStringPoolTest, threads)
+{
+  miutil::StringPool pool;
+  const int nthreads = 4, nstrings = 5000;
+  std::vector<std::vector<miutil::PooledString>> pooled(nthreads);
+  std::vector<std::thread> threads;
+  for (int t=0; t<nthreads; ++t) {
+    threads.emplace_back([&pool, &pooled, t]() {
+        for (int i=0; i<nstrings; ++i)
+          pooled[t].push_back(pool.intern("station-" + std::to_string((i * (t + 1)) % nstrings)));
+      });
+  }
+  for (std::thread& t : threads)
+    t.join();
+
+  EXPECT_EQ(nstrings, pool.size());
+  for (int t=0; t<nthreads; ++t) {
+    for (int i=0; i<nstrings; ++i)
+      EXPECT_EQ(pool.find("station-" + std::to_string((i * (t + 1)) % nstrings)), pooled[t][i]);
+  }
+}
@@ -0,0 +1,137 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for the one-pass multi-pattern replacement
+
+#include "miStringReplace.h"
+#include "miStringFunctions.h"
+#include <gtest/gtest.h>
+
+TEST(miStringReplaceTest, replace_all)
+{
+  EXPECT_EQ("b a c", miutil::replace_all("a b c", {{"a", "b"}, {"b", "a"}}));
+  EXPECT_EQ("no match", miutil::replace_all("no match", {{"x", "y"}}));
+  EXPECT_EQ("", miutil::replace_all("", {{"x", "y"}}));
+  EXPECT_EQ("XX", miutil::replace_all("aaaa", {{"aa", "X"}}));
+  EXPECT_EQ("ab", miutil::replace_all("ab", {}));
+}
+
+TEST(miStringReplaceTest, replace_all_inplace)
+{
+  std::string text = "%Y-%m-%d";
+  miutil::replace_all_inplace(text, {{"%Y", "2013"}, {"%m", "01"}, {"%d", "31"}});
+  EXPECT_EQ("2013-01-31", text);
+
+  // the copying overload also takes a std::string lvalue
+  const std::string copy = miutil::replace_all(text, {{"-", "/"}});
+  EXPECT_EQ("2013/01/31", copy);
+  EXPECT_EQ("2013-01-31", text);
+}
+
+TEST(miStringReplaceTest, longest)
+{
+  // the longest pattern wins, replacement text is not scanned again
+  const miutil::Replacer r({"%B", "%_B", "%", "B"});
+  const std::string_view to[] = { "Jan", "jan", "percent", "%B" };
+  EXPECT_EQ("Jan jan percent_ %B", r.replace("%B %_B %_ B", to));
+  EXPECT_EQ("percent", r.replace("%", to));
+}
+
+TEST(miStringReplaceTest, prefixes)
+{
+  // "abc" fails after "ab", but "ab" must still match
+  const miutil::Replacer r({"ab", "abcd", "b"});
+  const std::string_view to[] = { "1", "2", "3" };
+  EXPECT_EQ("1c", r.replace("abc", to));
+  EXPECT_EQ("2", r.replace("abcd", to));
+  EXPECT_EQ("x3a", r.replace("xba", to));
+}
+
+TEST(miStringReplaceTest, all_bytes)
+{
+  // patterns using all 256 byte values, each needing its own class
+  std::vector<std::string> patterns;
+  std::string text;
+  for (int b=0; b<256; ++b) {
+    patterns.push_back(std::string(1, char(b)) + "!");
+    text += char(b);
+    text += '!';
+  }
+  // the byte seen last is used again, and must not share a class with '\0'
+  patterns.push_back("\xff\xff");
+  text += "\xff\xff";
+  text += std::string(2, '\0');
+
+  const miutil::Replacer r(patterns);
+  std::string out;
+  r.replace(text, out, [](int pattern, std::string& o) { o += (pattern == 255) ? '.' : (pattern == 256) ? '#' : 'x'; });
+  EXPECT_EQ(std::string(255, 'x') + ".#" + std::string(2, '\0'), out);
+
+  int pattern;
+  EXPECT_EQ(510u, r.find(text, 509, pattern));
+  EXPECT_EQ(255, pattern);
+}
+
+TEST(miStringReplaceTest, find)
+{
+  const miutil::Replacer r({"", "cd", "c", "cd"});
+  EXPECT_EQ(4u, r.size());
+
+  int pattern;
+  EXPECT_EQ(2u, r.find("abcde", 0, pattern));
+  EXPECT_EQ(1, pattern);
+  EXPECT_EQ(2u, r.find("abc", 0, pattern));
+  EXPECT_EQ(2, pattern);
+  EXPECT_EQ(std::string_view::npos, r.find("abcde", 3, pattern));
+  EXPECT_EQ(miutil::Replacer::NO_PATTERN, pattern);
+}
+
+TEST(miStringReplaceTest, callback)
+{
+  const miutil::Replacer r({"$n", "$$"});
+  int calls = 0;
+  std::string out = "> ";
+  r.replace("$n, $n, $$n", out, [&](int pattern, std::string& o) {
+      if (pattern == 0)
+        miutil::append_number(o, ++calls);
+      else
+        o += '$';
+    });
+  EXPECT_EQ("> 1, 2, $n", out);
+  EXPECT_EQ(2, calls);
+}
+
+TEST(miStringReplaceTest, same_as_replace)
+{
+  const std::string text = "a long text with several words, some of them repeated; text text";
+  const char* patterns[] = { "text", "e", " ", "words", "xyz" };
+  for (const char* p : patterns) {
+    std::string expected = text;
+    miutil::replace(expected, p, "<>");
+    EXPECT_EQ(expected, miutil::replace_all(text, {{p, "<>"}})) << p;
+  }
+}
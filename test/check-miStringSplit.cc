@@ -0,0 +1,213 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for the string_view tokenizers
+
+#include "miStringSplit.h"
+#include <gtest/gtest.h>
+
+namespace {
+std::vector<std::string> collect(miutil::SplitViews&& splitter)
+{
+  std::vector<std::string> tokens;
+  for (std::string_view t : splitter)
+    tokens.emplace_back(t);
+  return tokens;
+}
+} // namespace
+
+TEST(miStringSplitTest, split_views)
+{
+  const char t1[] = " this   is a  string  ";
+  const std::vector<std::string> ve1 = { "this", "is", "a  string" };
+  const std::vector<std::string> ve2 = { "this", "is", "a", "string" };
+
+  EXPECT_EQ(ve1, collect(miutil::split_views(t1, 2)));
+  EXPECT_EQ(ve2, collect(miutil::split_views(t1, 8)));
+  EXPECT_EQ(ve2, collect(miutil::split_views(t1)));
+
+  EXPECT_TRUE(collect(miutil::split_views("", ":")).empty());
+  EXPECT_EQ(1, collect(miutil::split_views("one", ":")).size());
+}
+
+TEST(miStringSplitTest, split_views_clean)
+{
+  const std::vector<std::string> ve1 = { "a", "b", "c" };
+  EXPECT_EQ(ve1, collect(miutil::split_views("a: :b ::c: ", ":")));
+
+  // the empty token still counts for nos
+  const std::vector<std::string> ve2 = { "a", "b:c" };
+  EXPECT_EQ(ve2, collect(miutil::split_views("a: :b:c", 2, ":")));
+}
+
+TEST(miStringSplitTest, split_views_unclean)
+{
+  const std::vector<std::string> ve1 = { "", "a", "", " b " };
+  EXPECT_EQ(ve1, collect(miutil::split_views(",a,, b ,", ",", false)));
+
+  const std::vector<std::string> ve2 = { "a", ",b," };
+  EXPECT_EQ(ve2, collect(miutil::split_views("a,,b,", 1, ",", false)));
+}
+
+TEST(miStringSplitTest, split_views_next)
+{
+  const std::string line = "1 2 3";
+  miutil::SplitViews splitter(line, 0);
+  std::string_view token;
+  ASSERT_TRUE(splitter.next(token));
+  EXPECT_EQ("1", token);
+  EXPECT_EQ(line.data(), token.data());
+  ASSERT_TRUE(splitter.next(token));
+  ASSERT_TRUE(splitter.next(token));
+  EXPECT_EQ("3", token);
+  EXPECT_FALSE(splitter.next(token));
+  EXPECT_FALSE(splitter.next(token));
+}
+
+TEST(miStringSplitTest, for_each_token)
+{
+  std::vector<std::string> tokens;
+  EXPECT_TRUE(miutil::for_each_token("a b  c", miutil::whitespaces, true,
+                                     [&](std::string_view t) { tokens.emplace_back(t); }));
+  const std::vector<std::string> ve1 = { "a", "b", "c" };
+  EXPECT_EQ(ve1, tokens);
+
+  // stop after the 2nd token
+  int count = 0;
+  std::string_view second;
+  EXPECT_FALSE(miutil::for_each_token("x;y;z;(", ";", true, [&](std::string_view t) {
+        if (++count == 2) {
+          second = t;
+          return false;
+        }
+        return true;
+      }));
+  EXPECT_EQ(2, count);
+  EXPECT_EQ("y", second);
+}
+
+TEST(miStringSplitTest, for_each_token_protected)
+{
+  const char t1[] = " (protected text) in a  \"string  ";
+
+  std::vector<std::string> tokens;
+  miutil::for_each_token(t1, '(', ')', miutil::whitespaces, true,
+                         [&](std::string_view t) { tokens.emplace_back(t); });
+  const std::vector<std::string> ve1 = { "(protected text)", "in", "a", "\"string" };
+  EXPECT_EQ(ve1, tokens);
+
+  tokens.clear();
+  miutil::for_each_token(t1, '"', '"', miutil::whitespaces, true,
+                         [&](std::string_view t) { tokens.emplace_back(t); return tokens.size() < 2; });
+  const std::vector<std::string> ve2 = { "(protected", "text)" };
+  EXPECT_EQ(ve2, tokens);
+}
+
+TEST(miStringSplitTest, split_protected_pairs)
+{
+  miutil::SplitProtection protection;
+  protection.add('(', ')').add('[', ']').add('"', '"');
+
+  const std::vector<std::string> ve1 = { "f(a, b)", "[c d]", "\"e ( f\"", "g)" };
+  EXPECT_EQ(ve1, miutil::split_protected(" f(a, b) [c d] \"e ( f\" g) ", protection));
+
+  // not nested: the first ')' ends the protection
+  const std::vector<std::string> ve2 = { "(a (b)", "c)" };
+  EXPECT_EQ(ve2, miutil::split_protected("(a (b) c)", protection));
+
+  protection.nested();
+  const std::vector<std::string> ve3 = { "(a (b) [c)] \"(\")", "d" };
+  EXPECT_EQ(ve3, miutil::split_protected("(a (b) [c)] \"(\") d", protection));
+
+  // unbalanced, stop at the token with the open border
+  const std::vector<std::string> ve4 = { "a" };
+  EXPECT_EQ(ve4, miutil::split_protected("a (b [c)] d", protection));
+  EXPECT_EQ(ve4, miutil::split_protected("a \"b c", protection));
+}
+
+TEST(miStringSplitTest, split_protected_escape)
+{
+  miutil::SplitProtection protection('"', '"');
+  protection.escape('\\');
+
+  const std::vector<std::string> ve1 = { "a\\ b", "\"c \\\" d\"", "\\\"e" };
+  EXPECT_EQ(ve1, miutil::split_protected("a\\ b \"c \\\" d\" \\\"e", protection));
+
+  const std::vector<std::string> ve2 = { "a", "b\\" };
+  EXPECT_EQ(ve2, miutil::split_protected("a b\\", protection));
+}
+
+TEST(miStringSplitTest, split_into)
+{
+  const std::string lines[] = { " this   is a  string  ", "a,b,,c", "", "x y z w" };
+  miutil::TokenBuffer buffer;
+  for (const std::string& line : lines) {
+    EXPECT_EQ(miutil::split(line).size(), miutil::split_into(buffer, line));
+    EXPECT_EQ(miutil::split(line), buffer.strings());
+
+    EXPECT_EQ(miutil::split(line, 2, ",", false).size(), miutil::split_into(buffer, line, 2, ",", false));
+    EXPECT_EQ(miutil::split(line, 2, ",", false), buffer.strings());
+  }
+
+  miutil::split_into(buffer, "one two three");
+  ASSERT_EQ(3u, buffer.size());
+  EXPECT_EQ("one", buffer[0]);
+  EXPECT_EQ("three", buffer[2]);
+  std::vector<std::string> tokens(buffer.begin(), buffer.end());
+  EXPECT_EQ(buffer.strings(), tokens);
+}
+
+TEST(miStringSplitTest, split_into_reuse)
+{
+  miutil::TokenBuffer buffer;
+  miutil::split_into(buffer, "station;parameter;level;value");
+  const char* data = buffer[0].data();
+
+  // shorter input must not reallocate
+  miutil::split_into(buffer, "18700;air_temperature;2;12.5", ";");
+  ASSERT_EQ(4u, buffer.size());
+  EXPECT_EQ(data, buffer[0].data());
+  EXPECT_EQ("air_temperature", buffer[1]);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(miStringSplitTest, token_buffer_copy_move)
+{
+  miutil::TokenBuffer a;
+  miutil::split_into(a, "a bb ccc");
+  const miutil::TokenBuffer b(a);
+  miutil::TokenBuffer c(std::move(a));
+  EXPECT_EQ(b.strings(), c.strings());
+  EXPECT_TRUE(a.empty());
+  a.push_back("again");
+  EXPECT_EQ("again", a[0]);
+  c = b;
+  EXPECT_EQ(3u, c.size());
+  EXPECT_EQ("ccc", c[2]);
+}
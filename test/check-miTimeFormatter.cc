@@ -0,0 +1,136 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for TimeFormatter
+
+#include "miTimeFormatter.h"
+#include <gtest/gtest.h>
+
+#include <random>
+
+using miutil::miTime;
+using miutil::TimeFormatter;
+
+TEST(TimeFormatterTest, SameAsMiTime)
+{
+  const char* formats[] = {
+    "%Y-%m-%d %H:%M:%S", "%c", "%A %e. %B %Y", "%a %d %b %H:%M", "$time", "$date", "$autoclock", "$miniclock",
+    "%H $midnight24", "%k$midnight24", "%_A %_a %_B %_b", "%V %y %D", "%X %T %r %I %l %p $30M",
+    "$tz=CET %H %tz", "$tz=EST $dst %H", "$lg=nor %A %B", "%A $lg=nn", "%%B %%A", "$%dM", "plain", "", "%Q %% %"
+  };
+  const char* langs[] = { "", "en", "no", "nn", "de", "xx" };
+
+  std::vector<miTime> times = { miTime(2024, 3, 31, 0, 0, 0), miTime(2024, 10, 27, 2, 0, 0),
+                                miTime(2024, 1, 1, 0, 0, 5), miTime(2023, 12, 31, 23, 59, 59),
+                                miTime(2024, 6, 15, 13, 7, 0), miTime() };
+  std::mt19937 rng(1);
+  for (int i=0; i<20; ++i)
+    times.push_back(miTime(1990 + rng() % 50, 1 + rng() % 12, 1 + rng() % 28, rng() % 24,
+                           (rng() % 3) ? 0 : rng() % 60, (rng() % 3) ? 0 : rng() % 60));
+
+  for (const char* f : formats) {
+    for (const char* l : langs) {
+      for (bool utf8 : { false, true }) {
+        const TimeFormatter formatter(f, l, utf8);
+        for (const miTime& t : times) {
+          const std::string expected = t.format(f, l, utf8);
+          EXPECT_EQ(expected, formatter.format(t)) << f << " / " << l << " / " << t;
+        }
+      }
+    }
+  }
+}
+
+TEST(TimeFormatterTest, Directives)
+{
+  // expected output of miTime::format before the '$' directives were shared with TimeFormatter
+  const miTime times[] = { miTime(2024, 3, 31, 0, 0, 0), miTime(2024, 3, 31, 2, 30, 0), miTime(2024, 10, 27, 2, 0, 0),
+                           miTime(2024, 1, 1, 0, 0, 5), miTime(2023, 12, 31, 23, 59, 59), miTime(2024, 6, 15, 12, 0, 0),
+                           miTime(2024, 6, 15, 13, 7, 0) };
+  const struct {
+    const char* format;
+    const char* lang;
+    bool utf8;
+    int time;
+    const char* expected;
+  } cases[] = {
+    { "$time", "", false, 0, "2024-03-31 00:00:00" },
+    { "$time", "", false, 3, "2024-01-01 00:00:05" },
+    { "$date", "", false, 2, "2024-10-27" },
+    { "$autoclock", "", false, 0, "00" },
+    { "$autoclock", "", false, 1, "02:30" },
+    { "$autoclock", "", false, 3, "00:00:05" },
+    { "$miniclock", "", false, 0, "00" },
+    { "$miniclock", "", false, 1, "02:30" },
+    { "$miniclock", "", false, 4, "23:59" },
+    { "x$autoclock y", "", false, 6, "13:07 y" },
+    { "$tz=CET %H %tz", "", false, 0, "01 CET" },
+    { "$tz=CET %H %tz", "", false, 4, "00 CET" },
+    { "$tz=EST $dst %H", "", false, 0, "19" },
+    { "$tz=EST $dst %H", "", false, 6, "09" },
+    { "$dst %d %H", "", false, 1, "31 02" },
+    { "$dst %d %H", "", false, 2, "27 03" },
+    { "$tz=CET$dst %H", "", false, 4, "23" },
+    { "%H:%M $tz=JST $lg=nb %A", "", false, 0, "09:00 S\370ndag" },
+    { "%H:%M $tz=JST $lg=nb %A", "", false, 4, "08:59 Mandag" },
+    { "$lg=nor %A %B", "", false, 0, "S\370ndag Mars" },
+    { "$lg=nor %A %B", "", true, 0, "S\303\270ndag Mars" },
+    { "%A $lg=nn", "en", false, 3, "M\345ndag" },
+    { "$lg=de %B %b", "", true, 0, "M\303\244r M\303\244rz" },
+    { "%H $midnight24", "", false, 0, "24" },
+    { "%H $midnight24", "", false, 1, "02" },
+    { "%d.%m.%Y $midnight24 %k", "", false, 0, "30.03.2024 24" },
+    { "%d.%m.%Y $midnight24 %k", "", false, 3, "01.01.2024 0" },
+    { "$%dM", "", false, 0, "$31M" },
+    { "%%B %%A %%b", "", false, 0, "00arch 00unday 00ar" },
+    { "%%B %%A %%b", "", false, 2, "%October 00unday %Oct" },
+    { "$autoclock $miniclock $midnight24", "", false, 0, "24 24" },
+    { "$autoclock $miniclock $midnight24", "", false, 4, "23:59:59 23:59" },
+  };
+  for (const auto& c : cases) {
+    const miTime& t = times[c.time];
+    EXPECT_EQ(c.expected, t.format(c.format, c.lang, c.utf8)) << c.format << " / " << t;
+    EXPECT_EQ(c.expected, TimeFormatter(c.format, c.lang, c.utf8).format(t)) << c.format << " / " << t;
+  }
+}
+
+TEST(TimeFormatterTest, Buffer)
+{
+  const TimeFormatter formatter("%Y-%m-%d %H:%M");
+  const miTime t(2024, 2, 29, 6, 30, 0);
+
+  char buffer[16];
+  char* end = formatter.format(buffer, buffer + sizeof(buffer), t);
+  ASSERT_TRUE(end != nullptr);
+  EXPECT_EQ("2024-02-29 06:30", std::string(buffer, end));
+
+  EXPECT_EQ(nullptr, formatter.format(buffer, buffer + 15, t));
+
+  std::string out = "t=";
+  formatter.append(out, t);
+  EXPECT_EQ("t=2024-02-29 06:30", out);
+}
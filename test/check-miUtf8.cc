@@ -0,0 +1,167 @@
+/*
+  libpuTools - Basic types/algorithms/containers
+
+  Copyright (C) 2026 met.no
+
+  Contact information:
+  Norwegian Meteorological Institute
+  Box 43 Blindern
+  0313 OSLO
+  NORWAY
+  email: diana@met.no
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+// Test cases for latin1 / UTF-8 conversion
+
+#include "miUtf8.h"
+#include "miCharSet.h"
+#include "miStringFunctions.h"
+#include <gtest/gtest.h>
+
+namespace {
+// the implementation of from_latin1_to_utf8 before miUtf8 was added
+std::string latin1_to_utf8_bytewise(const std::string& latin1)
+{
+  std::string utf8;
+  for (char ch : latin1) {
+    unsigned char uch = static_cast<unsigned char>(ch);
+    if ((uch & 0x80) != 0) {
+      utf8 += static_cast<char>(0xc0 | (uch >> 6));
+      uch = (0x80 | (uch & 0x3f));
+    }
+    utf8 += static_cast<char>(uch);
+  }
+  return utf8;
+}
+
+std::string all_latin1()
+{
+  std::string text;
+  for (int r=0; r<3; ++r) {
+    text += "plain ASCII text, long enough for a few SIMD blocks; ";
+    for (int i=0; i<256; ++i)
+      text += static_cast<char>((i * 13 + r) & 0xFF);
+  }
+  return text;
+}
+} // namespace
+
+class Utf8EngineTest : public ::testing::TestWithParam<miutil::CharSet::Engine> {
+protected:
+  void SetUp() override
+    { previous = miutil::CharSet::engine(); }
+  void TearDown() override
+    { miutil::CharSet::selectEngine(previous); }
+
+  miutil::CharSet::Engine previous;
+};
+
+TEST_P(Utf8EngineTest, round_trip)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  const std::string latin1 = all_latin1();
+  for (size_t offset=0; offset<33; ++offset) {
+    const std::string in = latin1.substr(offset);
+    const std::string utf8 = miutil::from_latin1_to_utf8(in);
+    EXPECT_EQ(latin1_to_utf8_bytewise(in), utf8);
+    EXPECT_EQ(utf8.size(), miutil::utf8_size_of_latin1(in));
+    EXPECT_TRUE(miutil::is_valid_utf8(utf8));
+    EXPECT_EQ(in, miutil::from_utf8_to_latin1(utf8));
+  }
+}
+
+TEST_P(Utf8EngineTest, ascii_prefix)
+{
+  if (!miutil::CharSet::selectEngine(GetParam()))
+    GTEST_SKIP() << "engine not supported";
+
+  std::string text(100, 'a');
+  EXPECT_EQ(100u, miutil::ascii_prefix(text));
+  for (size_t i : { 0, 1, 15, 16, 31, 32, 33, 63, 64, 99 }) {
+    std::string t = text;
+    t[i] = '\xE5';
+    EXPECT_EQ(i, miutil::ascii_prefix(t));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, Utf8EngineTest,
+                         ::testing::Values(miutil::CharSet::ENGINE_SCALAR, miutil::CharSet::ENGINE_SSE2,
+                                           miutil::CharSet::ENGINE_AVX2));
+
+TEST(miUtf8Test, validate)
+{
+  EXPECT_TRUE(miutil::is_valid_utf8(""));
+  EXPECT_TRUE(miutil::is_valid_utf8("bl\xc3\xa5" "b\xc3\xa6r \xe2\x82\xac \xf0\x9f\x98\x80"));
+  EXPECT_TRUE(miutil::is_valid_utf8("\xed\x9f\xbf\xf4\x8f\xbf\xbf"));  // U+D7FF U+10FFFF
+
+  EXPECT_EQ(2u, miutil::find_invalid_utf8("ab\xe5" "c"));     // latin1
+  EXPECT_EQ(0u, miutil::find_invalid_utf8("\xc0\xaf"));       // overlong
+  EXPECT_EQ(0u, miutil::find_invalid_utf8("\xe0\x80\xaf"));   // overlong
+  EXPECT_EQ(0u, miutil::find_invalid_utf8("\xed\xa0\x80"));   // surrogate
+  EXPECT_EQ(0u, miutil::find_invalid_utf8("\xf4\x90\x80\x80")); // above U+10FFFF
+  EXPECT_EQ(1u, miutil::find_invalid_utf8("a\xc3"));          // truncated
+  EXPECT_EQ(0u, miutil::find_invalid_utf8("\x80"));           // continuation
+}
+
+TEST(miUtf8Test, to_latin1)
+{
+  EXPECT_EQ("bl\xe5" "b\xe6r ? ?", miutil::from_utf8_to_latin1("bl\xc3\xa5" "b\xc3\xa6r \xe2\x82\xac \xf0\x9f\x98\x80"));
+  EXPECT_EQ("a__b", miutil::from_utf8_to_latin1("a\xe5\xc3" "b", '_'));
+  EXPECT_EQ("a__", miutil::from_utf8_to_latin1("a\xe2\x82", '_'));
+
+  miutil::Utf8ToLatin1Converter converter;
+  std::string out;
+  converter.convert("\xc3\xa5", out);
+  EXPECT_TRUE(converter.finish(out));
+  EXPECT_EQ("\xe5", out);
+  EXPECT_EQ(0u, converter.errors());
+}
+
+TEST(miUtf8Test, streaming)
+{
+  const std::string latin1 = all_latin1();
+  const std::string utf8 = miutil::from_latin1_to_utf8(latin1) + "\xe2\x82\xac";
+  for (size_t chunk : { 1, 2, 3, 5, 16, 100 }) {
+    miutil::Utf8ToLatin1Converter to_latin1;
+    miutil::Latin1ToUtf8Converter to_utf8;
+    std::string l, u;
+    for (size_t pos=0; pos<utf8.size(); pos += chunk)
+      to_latin1.convert(std::string_view(utf8).substr(pos, chunk), l);
+    EXPECT_FALSE(to_latin1.finish(l));
+    EXPECT_EQ(1u, to_latin1.errors());
+    EXPECT_EQ(latin1 + "?", l);
+
+    for (size_t pos=0; pos<latin1.size(); pos += chunk)
+      to_utf8.convert(std::string_view(latin1).substr(pos, chunk), u);
+    EXPECT_TRUE(to_utf8.finish(u));
+    EXPECT_EQ(utf8.substr(0, utf8.size() - 3), u);
+  }
+
+  // split invalid sequences
+  for (size_t split=0; split<=4; ++split) {
+    const std::string bad = "\xe2\x82" "A\xf0\x9f\x98";
+    miutil::Utf8ToLatin1Converter c;
+    std::string out;
+    c.convert(std::string_view(bad).substr(0, split), out);
+    c.convert(std::string_view(bad).substr(split), out);
+    c.finish(out);
+    EXPECT_EQ(miutil::from_utf8_to_latin1(bad), out) << split;
+    EXPECT_EQ(5u, c.errors()) << split;
+  }
+}